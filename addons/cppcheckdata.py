@@ -7,9 +7,11 @@ License: No restrictions, use this as you need.
 """
 
 import argparse
+import array
 import json
 import os
 import sys
+import struct
 import subprocess
 
 try:
@@ -1175,6 +1177,62 @@ class Standards:
         )
 
 
+BINARY_DUMP_MAGIC = b'CPPCHECKDUMP'
+
+
+def _iterparse_binary(filename):
+    """
+    Iterate over the elements of a binary dump file (--dump-format=binary) like
+    ElementTree.iterparse() with the events 'start' and 'end'.
+    """
+    with open(filename, 'rb') as f:
+        data = f.read()
+    pos = len(BINARY_DUMP_MAGIC)
+    version, item_count, strings_size = struct.unpack_from('<III', data, pos)
+    if version != 1:
+        raise ValueError('unsupported binary dump version %d' % version)
+    pos += 12
+    items = array.array('I')
+    if items.itemsize != 4:
+        items = array.array('L')
+    items.frombytes(data[pos:pos + 4 * item_count])
+    if sys.byteorder == 'big':
+        items.byteswap()
+    pos += 4 * item_count
+    strings = data[pos:pos + strings_size].decode('utf-8', 'replace').split('\0')
+    string = strings.__getitem__
+    del data
+
+    Element = ElementTree.Element
+    stack = []
+    i = 0
+    while i < item_count:
+        tag = items[i]
+        if tag == 0:
+            yield 'end', stack.pop()
+            i += 1
+            continue
+        end = i + 2 + 2 * items[i + 1]
+        node = Element(strings[tag], dict(zip(map(string, items[i + 2:end:2]), map(string, items[i + 3:end:2]))))
+        if stack:
+            stack[-1].append(node)
+        stack.append(node)
+        yield 'start', node
+        i = end
+
+
+def iterparse(filename):
+    """
+    Iterate over the elements of a dump file with the events 'start' and 'end'. The
+    dump can be written in the XML or in the binary format.
+    """
+    with open(filename, 'rb') as f:
+        binary = (f.read(len(BINARY_DUMP_MAGIC)) == BINARY_DUMP_MAGIC)
+    if binary:
+        return _iterparse_binary(filename)
+    return ElementTree.iterparse(filename, events=('start', 'end'))
+
+
 class CppcheckData:
     """
     Class that makes cppcheck dump data available
@@ -1232,7 +1290,7 @@ class CppcheckData:
         # Parse general configuration options from <dumps> node
         # We intentionally don't clean node resources here because we
         # want to serialize in memory only small part of the XML tree.
-        for event, node in ElementTree.iterparse(self.filename, events=('start', 'end')):
+        for event, node in iterparse(self.filename):
             if platform_done and rawtokens_done and suppressions_done:
                 break
             if node.tag == 'dumps':
@@ -1291,7 +1349,7 @@ class CppcheckData:
         # Use iterable objects to traverse XML tree for dump files incrementally.
         # Iterative approach is required to avoid large memory consumption.
         # Calling .clear() is necessary to let the element be garbage collected.
-        for event, node in ElementTree.iterparse(self.filename, events=('start', 'end')):
+        for event, node in iterparse(self.filename):
             # Serialize new configuration node
             if node.tag == 'dump':
                 if event == 'start':
@@ -1,10 +1,51 @@
 import cppcheckdata
 import cppcheck
+import json
 import runpy
 import sys
 import os
+import traceback
+
+
+def run_server(addon, args):
+    # Each line on stdin contains the JSON array of the arguments of one run. The output of
+    # each run is terminated with a JSON line that contains its exit code.
+    with open(addon, 'rb') as f:
+        code = compile(f.read(), addon, 'exec')
+    sys.stderr = sys.stdout
+    while True:
+        request = sys.stdin.readline()
+        if not request:
+            break
+        sys.argv = [addon] + args + json.loads(request)
+        del cppcheck.__checkers__[:]
+        cppcheckdata.EXIT_CODE = 0
+        try:
+            exec(code, {'__name__': '__main__', '__file__': addon, '__builtins__': __builtins__})
+
+            # Run registered checkers
+            cppcheck.runcheckers()
+            exitcode = cppcheckdata.EXIT_CODE
+        except SystemExit as e:
+            if e.code is None:
+                exitcode = 0
+            elif isinstance(e.code, int):
+                exitcode = e.code
+            else:
+                print(e.code)
+                exitcode = 1
+        except Exception:
+            traceback.print_exc()
+            exitcode = 1
+        sys.stdout.write('\n' + json.dumps({'exitcode': exitcode & 0xff}) + '\n')
+        sys.stdout.flush()
+
 
 if __name__ == '__main__':
+    if sys.argv[1] == '--server':
+        run_server(sys.argv[2], sys.argv[3:])
+        sys.exit(0)
+
     addon = sys.argv[1]
     __addon_name__ = os.path.splitext(os.path.basename(addon))[0]
     sys.argv.pop(0)
@@ -13,4 +54,4 @@ if __name__ == '__main__':
 
     # Run registered checkers
     cppcheck.runcheckers()
-    sys.exit(cppcheckdata.EXIT_CODE)
\ No newline at end of file
+    sys.exit(cppcheckdata.EXIT_CODE)
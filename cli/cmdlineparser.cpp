@@ -546,9 +546,24 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
         else if (std::strncmp(argv[i],"--addon-python=", 15) == 0)
             mSettings.addonPython.assign(argv[i]+15);
 
+        else if (std::strcmp(argv[i], "--addon-server") == 0)
+            mSettings.addonServer = true;
+
         else if (std::strcmp(argv[i],"--analyze-all-vs-configs") == 0)
             mSettings.analyzeAllVsConfigs = true;
 
+        else if (std::strncmp(argv[i], "--analyzer-info-format=", 23) == 0) {
+            const std::string format = argv[i] + 23;
+            if (format == "binary")
+                mSettings.analyzerInfoFormat = Settings::AnalyzerInfoFormat::binary;
+            else if (format == "xml")
+                mSettings.analyzerInfoFormat = Settings::AnalyzerInfoFormat::xml;
+            else {
+                mLogger.printError("argument to '--analyzer-info-format=' must be 'binary' or 'xml'.");
+                return Result::Fail;
+            }
+        }
+
         // Check configuration
         else if (std::strcmp(argv[i], "--check-config") == 0)
             mSettings.checkConfiguration = true;
@@ -597,7 +612,27 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             mSettings.checkersReportFilename = argv[i] + 18;
 
         else if (std::strncmp(argv[i], "--checks-max-time=", 18) == 0) {
-            if (!parseNumberArg(argv[i], 18, mSettings.checksMaxTime, true))
+            // --checks-max-time=<check>:<seconds> sets the time of a single check
+            const char * const checkMaxTime = std::strrchr(argv[i] + 18, ':');
+            if (checkMaxTime) {
+                const std::string checkName(argv[i] + 18, checkMaxTime);
+                if (checkName.empty()) {
+                    mLogger.printError("no check provided for --checks-max-time.");
+                    return Result::Fail;
+                }
+                int seconds;
+                std::string err;
+                if (!strToInt(checkMaxTime + 1, seconds, &err)) {
+                    mLogger.printError("time of check '" + checkName + "' for --checks-max-time is not valid - " + err + ".");
+                    return Result::Fail;
+                }
+                if (seconds < 0) {
+                    mLogger.printError("time of check '" + checkName + "' for --checks-max-time needs to be a positive integer.");
+                    return Result::Fail;
+                }
+                mSettings.checkMaxTime[checkName] = seconds;
+            }
+            else if (!parseNumberArg(argv[i], 18, mSettings.checksMaxTime, true))
                 return Result::Fail;
         }
 
@@ -632,6 +667,26 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             }
         }
 
+        else if (std::strncmp(argv[i], "--config-jobs=", 14) == 0) {
+#if defined(HAS_THREADING_MODEL_THREAD)
+            int tmp;
+            if (!parseNumberArg(argv[i], 14, tmp))
+                return Result::Fail;
+            if (tmp < 1) {
+                mLogger.printError("argument to '--config-jobs=' must be greater than 0.");
+                return Result::Fail;
+            }
+            if (tmp > 1024) {
+                mLogger.printError("argument to '--config-jobs=' is allowed to be 1024 at max.");
+                return Result::Fail;
+            }
+            mSettings.configJobs = tmp;
+#else
+            mLogger.printError("Option --config-jobs cannot be used as Cppcheck has not been built with a respective threading model.");
+            return Result::Fail;
+#endif
+        }
+
         else if (std::strncmp(argv[i], "--cppcheck-build-dir=", 21) == 0) {
             std::string path = Path::fromNativeSeparators(argv[i] + 21);
             if (path.empty()) {
@@ -716,6 +771,18 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
         else if (std::strcmp(argv[i], "--dump") == 0)
             mSettings.dump = true;
 
+        else if (std::strncmp(argv[i], "--dump-format=", 14) == 0) {
+            const std::string format = argv[i] + 14;
+            if (format == "xml")
+                mSettings.dumpFormat = Settings::DumpFormat::xml;
+            else if (format == "binary")
+                mSettings.dumpFormat = Settings::DumpFormat::binary;
+            else {
+                mLogger.printError("argument to '--dump-format=' must be 'xml' or 'binary'.");
+                return Result::Fail;
+            }
+        }
+
         else if (std::strcmp(argv[i], "--emit-duplicates") == 0)
             mSettings.emitDuplicates = true;
 
@@ -1088,6 +1155,27 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                 return Result::Fail;
         }
 
+        // Experimental: analyze independent function scopes in parallel
+        else if (std::strncmp(argv[i], "--performance-valueflow-jobs=", 29) == 0) {
+#if defined(HAS_THREADING_MODEL_THREAD)
+            int tmp;
+            if (!parseNumberArg(argv[i], 29, tmp))
+                return Result::Fail;
+            if (tmp < 1) {
+                mLogger.printError("argument to '--performance-valueflow-jobs=' must be greater than 0.");
+                return Result::Fail;
+            }
+            if (tmp > 1024) {
+                mLogger.printError("argument to '--performance-valueflow-jobs=' is allowed to be 1024 at max.");
+                return Result::Fail;
+            }
+            mSettings.vfOptions.jobs = tmp;
+#else
+            mLogger.printError("Option --performance-valueflow-jobs cannot be used as Cppcheck has not been built with a respective threading model.");
+            return Result::Fail;
+#endif
+        }
+
         // Specify platform
         else if (std::strncmp(argv[i], "--platform=", 11) == 0) {
             const std::string platform(11+argv[i]);
@@ -1178,6 +1266,15 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             }
         }
 
+        else if (std::strcmp(argv[i], "--process-pool") == 0) {
+#if defined(HAS_THREADING_MODEL_FORK)
+            mSettings.processPool = true;
+#else
+            mLogger.printError("option '--process-pool' cannot be used as Cppcheck has not been built with a respective threading model.");
+            return Result::Fail;
+#endif
+        }
+
         // --project
         else if (std::strncmp(argv[i], "--project=", 10) == 0) {
             if (projectType != ImportProject::Type::NONE)
@@ -1285,6 +1382,11 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                 return Result::Fail;
         }
 
+        else if (std::strncmp(argv[i], "--report-slow-checks=", 21) == 0) {
+            if (!parseNumberArg(argv[i], 21, mSettings.reportSlowChecks, true))
+                return Result::Fail;
+        }
+
         else if (std::strncmp(argv[i], "--report-type=", 14) == 0) {
             const std::string typeStr = argv[i] + 14;
             if (typeStr == "normal") {
@@ -1445,6 +1547,15 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             }
         }
 
+        // Write the timer scopes to a trace file
+        else if (std::strncmp(argv[i], "--showtime-trace=", 17) == 0) {
+            mSettings.showtimeTraceFile = argv[i] + 17;
+            if (mSettings.showtimeTraceFile.empty()) {
+                mLogger.printError("no file provided for --showtime-trace");
+                return Result::Fail;
+            }
+        }
+
         // --std
         else if (std::strncmp(argv[i], "--std=", 6) == 0) {
             const std::string std = argv[i] + 6;
@@ -1588,6 +1699,10 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
     // TODO: bail out?
     if (!executorAuto && mSettings.useSingleJob())
         mLogger.printMessage("'--executor' has no effect as only a single job will be used.");
+#if defined(HAS_THREADING_MODEL_FORK)
+    if (mSettings.processPool && !mSettings.useSingleJob() && mSettings.executor != Settings::ExecutorType::Process)
+        mLogger.printMessage("'--process-pool' has no effect as the executor type 'process' is not used.");
+#endif
 
     // Default template format..
     if (mSettings.templateFormat.empty()) {
@@ -1716,6 +1831,13 @@ void CmdLineParser::printHelp() const
         "                         addon json files or through this command line option.\n"
         "                         If not present, Cppcheck will try \"python3\" first and\n"
         "                         then \"python\".\n"
+        "    --addon-server       Run each python addon in a long-lived process per thread\n"
+        "                         instead of starting the interpreter for every file.\n"
+        "    --analyzer-info-format=<format>\n"
+        "                         Format of the analysis results that are stored in the\n"
+        "                         --cppcheck-build-dir:\n"
+        "                          * binary: Compact format (default).\n"
+        "                          * xml: XML format that can be read by other tools.\n"
         "    --cppcheck-build-dir=<dir>\n"
         "                         Cppcheck work folder. Advantages:\n"
         "                          * whole program analysis\n"
@@ -1751,12 +1873,21 @@ void CmdLineParser::printHelp() const
         "                         be considered for evaluation.\n"
         "    --config-excludes-file=<file>\n"
         "                         A file that contains a list of config-excludes\n"
+        "    --config-jobs=<jobs> Simplify up to <jobs> preprocessor configurations of a\n"
+        "                         file simultaneously. The results are reported in the\n"
+        "                         same order as in a sequential analysis.\n"
         "    --disable=<id>       Disable individual checks.\n"
         "                         Please refer to the documentation of --enable=<id>\n"
         "                         for further details.\n"
         "    --dump               Dump xml data for each translation unit. The dump\n"
         "                         files have the extension .dump and contain ast,\n"
         "                         tokenlist, symboldatabase, valueflow.\n"
+        "    --dump-format=<format>\n"
+        "                         Format of the dump files that are written for --dump\n"
+        "                         and the addons:\n"
+        "                          * xml: XML format (default).\n"
+        "                          * binary: Compact format that can be read with\n"
+        "                            cppcheckdata.py.\n"
         "    -D<ID>               Define preprocessor symbol. Unless --max-configs or\n"
         "                         --force is used, Cppcheck will only check the given\n"
         "                         configuration when -D is used.\n"
@@ -1916,6 +2047,9 @@ void CmdLineParser::printHelp() const
     }
 
     oss <<
+        "    --process-pool       Start the processes of --executor=process once and pass\n"
+        "                         the files to them instead of starting a process per file.\n"
+        "                         A process that crashes is replaced.\n"
         "    --project=<file>     Run Cppcheck on project. The <file> can be a Visual\n"
         "                         Studio Solution (*.sln), Visual Studio Project\n"
         "                         (*.vcxproj), compile database (compile_commands.json),\n"
@@ -1938,6 +2072,10 @@ void CmdLineParser::printHelp() const
         "                         currently only possible to apply the base paths to\n"
         "                         files that are on a lower level in the directory tree.\n"
         "    --report-progress    Report progress messages while checking a file (single job only).\n"
+        "    --report-slow-checks=<n>\n"
+        "                         Report the n slowest checks of the checked files at the end\n"
+        "                         of the analysis. The checks that are run by --executor=process\n"
+        "                         are not included.\n"
         "    --report-type=<type> Add guideline and classification fields for specified coding standard.\n"
         "                         The available report types are:\n"
         "                          * normal           Default, only show cppcheck error ID and severity\n"
@@ -1970,6 +2108,12 @@ void CmdLineParser::printHelp() const
         "                                 Show the top 5 summary at the end\n"
         "                          * top5\n"
         "                                 Alias for top5_file (deprecated)\n"
+        "    --showtime-trace=<file>\n"
+        "                         Write the wall clock and CPU time of the analysis phases\n"
+        "                         of each thread to a Chrome trace event file that can be\n"
+        "                         opened in chrome://tracing or https://ui.perfetto.dev.\n"
+        "                         The phases of the processes of --executor=process are not\n"
+        "                         included, use --executor=thread instead.\n"
         "    --std=<id>           Set standard.\n"
         "                         The available options are:\n"
         "                          * c89\n"
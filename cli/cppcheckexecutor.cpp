@@ -36,6 +36,7 @@
 #include "settings.h"
 #include "singleexecutor.h"
 #include "suppressions.h"
+#include "timer.h"
 #include "utils.h"
 
 #if defined(HAS_THREADING_MODEL_THREAD)
@@ -448,6 +449,9 @@ int CppCheckExecutor::check_internal(const Settings& settings, Suppressions& sup
 
     CppCheck cppcheck(settings, supprs, stdLogger, true, executeCommand);
 
+    if (!settings.showtimeTraceFile.empty())
+        TimerTrace::start();
+
     unsigned int returnValue = 0;
     if (settings.useSingleJob()) {
         // Single process
@@ -470,6 +474,17 @@ int CppCheckExecutor::check_internal(const Settings& settings, Suppressions& sup
 
     returnValue |= cppcheck.analyseWholeProgram(settings.buildDir, mFiles, mFileSettings, stdLogger.getCtuInfo());
 
+    if (settings.reportSlowChecks > 0)
+        CppCheck::printSlowChecks();
+
+    if (!settings.showtimeTraceFile.empty()) {
+        if (!TimerTrace::write(settings.showtimeTraceFile)) {
+            CmdLineLoggerStd logger;
+            logger.printError("could not write trace file '" + settings.showtimeTraceFile + "'.");
+        }
+        TimerTrace::reset();
+    }
+
     if (settings.severity.isEnabled(Severity::information) || settings.checkConfiguration) {
         const bool err = reportSuppressions(settings, supprs.nomsg, settings.checks.isEnabled(Checks::unusedFunction), mFiles, mFileSettings, stdLogger);
         if (err && returnValue == 0)
@@ -45,6 +45,8 @@
 #include <list>
 #include <map>
 #include <sstream>
+#include <vector>
+#include <poll.h>
 #include <sys/select.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -84,6 +86,8 @@ namespace {
 
         void reportOut(const std::string &outmsg, Color c) override {
             writeToPipe(REPORT_OUT, static_cast<char>(c) + outmsg);
+            // status messages are shown immediately
+            flush();
         }
 
         void reportErr(const ErrorMessage &msg) override {
@@ -102,6 +106,7 @@ namespace {
 
         void writeEnd(const std::string& str) const {
             writeToPipe(CHILD_END, str);
+            flush();
         }
 
     private:
@@ -116,103 +121,82 @@ namespace {
         }
 
         // TODO: how to log file name in error?
-        void writeToPipeInternal(PipeSignal type, const void* data, std::size_t to_write) const
+        void flush() const
         {
-            const ssize_t bytes_written = write(mWpipe, data, to_write);
-            if (bytes_written <= 0) {
-                const int err = errno;
-                std::cerr << "#### ThreadExecutor::writeToPipeInternal() error for type " << type << ": " << std::strerror(err) << std::endl;
-                std::exit(EXIT_FAILURE);
-            }
-            // TODO: write until everything is written
-            if (bytes_written != to_write) {
-                std::cerr << "#### ThreadExecutor::writeToPipeInternal() error for type " << type << ": insufficient data written (expected: " << to_write << " / got: " << bytes_written << ")" << std::endl;
-                std::exit(EXIT_FAILURE);
+            const char *data = mBuffer.data();
+            std::size_t to_write = mBuffer.size();
+            while (to_write > 0) {
+                const ssize_t bytes_written = write(mWpipe, data, to_write);
+                if (bytes_written < 0 && errno == EINTR)
+                    continue;
+                if (bytes_written <= 0) {
+                    const int err = errno;
+                    std::cerr << "#### ThreadExecutor::flush() error: " << std::strerror(err) << std::endl;
+                    std::exit(EXIT_FAILURE);
+                }
+                data += bytes_written;
+                to_write -= bytes_written;
             }
+            mBuffer.clear();
         }
 
+        /** the messages are collected and written in batches */
         void writeToPipe(PipeSignal type, const std::string &data) const
         {
-            {
-                const auto t = static_cast<char>(type);
-                writeToPipeInternal(type, &t, 1);
-            }
-
+            mBuffer += static_cast<char>(type);
             const auto len = static_cast<unsigned int>(data.length());
-            {
-                static constexpr std::size_t l_size = sizeof(unsigned int);
-                writeToPipeInternal(type, &len, l_size);
-            }
-
-            if (len > 0) // TODO: unexpected - write a warning?
-                writeToPipeInternal(type, data.c_str(), len);
+            mBuffer.append(reinterpret_cast<const char *>(&len), sizeof(len));
+            mBuffer += data;
+            if (mBuffer.size() >= 64 * 1024)
+                flush();
         }
 
         const int mWpipe;
+        mutable std::string mBuffer;
     };
 }
 
-bool ProcessExecutor::handleRead(int rpipe, unsigned int &result, const std::string& filename)
+ProcessExecutor::ReadResult ProcessExecutor::handleRead(int rpipe, std::string &buffer, unsigned int &result, const std::string& filename)
 {
-    std::size_t bytes_to_read;
-    ssize_t bytes_read;
-
-    char type = 0;
-    bytes_to_read = sizeof(char);
-    bytes_read = read(rpipe, &type, bytes_to_read);
+    char data[64 * 1024];
+    const ssize_t bytes_read = read(rpipe, data, sizeof(data));
+    if (bytes_read < 0 && (errno == EAGAIN || errno == EINTR))
+        return ReadResult::Continue;
     if (bytes_read <= 0) {
-        if (errno == EAGAIN)
-            return true;
-
         // TODO: log details about failure
-
-        // need to increment so a missing pipe (i.e. premature exit of forked process) results in an error exitcode
-        ++result;
-        return false;
-    }
-    if (bytes_read != bytes_to_read) {
-        std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") error (type): insufficient data read (expected: " << bytes_to_read << " / got: " << bytes_read << ")" << std::endl;
-        std::exit(EXIT_FAILURE);
+        return ReadResult::Failure;
     }
+    buffer.append(data, bytes_read);
 
-    if (type != PipeWriter::REPORT_OUT &&
-        type != PipeWriter::REPORT_ERROR &&
-        type != PipeWriter::REPORT_SUPPR_INLINE &&
-        type != PipeWriter::REPORT_SUPPR &&
-        type != PipeWriter::CHILD_END) {
-        std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") invalid type " << int(type) << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
+    // handle all complete messages
+    static constexpr std::size_t header_size = sizeof(char) + sizeof(unsigned int);
+    std::size_t pos = 0;
+    bool res = true;
+    while (res && buffer.size() - pos >= header_size) {
+        const char type = buffer[pos];
+        if (type != PipeWriter::REPORT_OUT &&
+            type != PipeWriter::REPORT_ERROR &&
+            type != PipeWriter::REPORT_SUPPR_INLINE &&
+            type != PipeWriter::REPORT_SUPPR &&
+            type != PipeWriter::CHILD_END) {
+            std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") invalid type " << int(type) << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
 
-    unsigned int len = 0;
-    bytes_to_read = sizeof(len);
-    bytes_read = read(rpipe, &len, bytes_to_read);
-    if (bytes_read <= 0) {
-        const int err = errno;
-        std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") error (len) for type " << int(type) << ": " << std::strerror(err) << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-    if (bytes_read != bytes_to_read) {
-        std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") error (len) for type" << int(type) << ": insufficient data read (expected: " << bytes_to_read << " / got: " << bytes_read << ")"  << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
+        unsigned int len = 0;
+        std::memcpy(&len, buffer.data() + pos + sizeof(char), sizeof(len));
+        if (buffer.size() - pos - header_size < len)
+            break;
 
-    std::string buf(len, '\0');
-    if (len > 0) { // TODO: unexpected - write a warning?
-        char *data_start = &buf[0];
-        bytes_to_read = len;
-        do {
-            bytes_read = read(rpipe, data_start, bytes_to_read);
-            if (bytes_read <= 0) {
-                const int err = errno;
-                std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") error (buf) for type" << int(type) << ": " << std::strerror(err) << std::endl;
-                std::exit(EXIT_FAILURE);
-            }
-            bytes_to_read -= bytes_read;
-            data_start += bytes_read;
-        } while (bytes_to_read != 0);
+        res = handleMessage(type, buffer.substr(pos + header_size, len), result, filename);
+        pos += header_size + len;
     }
+    buffer.erase(0, pos);
+    return res ? ReadResult::Continue : ReadResult::ChildEnd;
+}
 
+bool ProcessExecutor::handleMessage(char type, const std::string &buf, unsigned int &result, const std::string& filename)
+{
     bool res = true;
     if (type == PipeWriter::REPORT_OUT) {
         // the first character is the color
@@ -285,6 +269,9 @@ bool ProcessExecutor::checkLoadAverage(size_t nchildren)
 
 unsigned int ProcessExecutor::check()
 {
+    if (mSettings.processPool)
+        return checkPool();
+
     unsigned int fileCount = 0;
     unsigned int result = 0;
 
@@ -295,6 +282,7 @@ unsigned int ProcessExecutor::check()
     std::list<int> rpipes;
     std::map<pid_t, std::string> childFile;
     std::map<int, std::string> pipeFile;
+    std::map<int, std::string> pipeBuffer;
     std::size_t processedsize = 0;
     auto iFile = mFiles.cbegin();
     auto iFileSettings = mFileSettings.cbegin();
@@ -378,8 +366,11 @@ unsigned int ProcessExecutor::check()
                         if (p != pipeFile.cend()) {
                             name = p->second;
                         }
-                        const bool readRes = handleRead(*rp, result, name);
-                        if (!readRes) {
+                        const ReadResult readRes = handleRead(*rp, pipeBuffer[*rp], result, name);
+                        if (readRes != ReadResult::Continue) {
+                            // need to increment so a missing pipe (i.e. premature exit of forked process) results in an error exitcode
+                            if (readRes == ReadResult::Failure)
+                                ++result;
                             std::size_t size = 0;
                             if (p != pipeFile.cend()) {
                                 pipeFile.erase(p);
@@ -396,6 +387,7 @@ unsigned int ProcessExecutor::check()
                             if (!mSettings.quiet)
                                 Executor::reportStatus(fileCount, mFiles.size() + mFileSettings.size(), processedsize, totalfilesize);
 
+                            pipeBuffer.erase(*rp);
                             close(*rp);
                             rp = rpipes.erase(rp);
                         } else
@@ -443,6 +435,243 @@ unsigned int ProcessExecutor::check()
     return result;
 }
 
+namespace {
+    /** a file that is checked by a child of the process pool */
+    struct PoolTask {
+        const FileWithDetails *file;
+        const FileSettings *fileSettings;
+        std::string name;
+        std::size_t size;
+    };
+
+    /** a child of the process pool */
+    struct PoolChild {
+        pid_t pid;
+        /** the indices of the files to check are written to this pipe, it is closed when all files have been assigned */
+        int control;
+        /** the results are read from this pipe */
+        int results;
+        /** data of the results pipe that has not been handled yet */
+        std::string buffer;
+        /** the file that is checked by the child */
+        std::size_t task;
+    };
+}
+
+static constexpr std::size_t noTask = static_cast<std::size_t>(-1);
+
+static bool readAll(int fd, void *data, std::size_t size)
+{
+    auto *p = static_cast<char *>(data);
+    while (size > 0) {
+        const ssize_t bytes_read = read(fd, p, size);
+        if (bytes_read < 0 && errno == EINTR)
+            continue;
+        if (bytes_read <= 0)
+            return false;
+        p += bytes_read;
+        size -= bytes_read;
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const void *data, std::size_t size)
+{
+    const auto *p = static_cast<const char *>(data);
+    while (size > 0) {
+        const ssize_t bytes_written = write(fd, p, size);
+        if (bytes_written < 0 && errno == EINTR)
+            continue;
+        if (bytes_written <= 0)
+            return false;
+        p += bytes_written;
+        size -= bytes_written;
+    }
+    return true;
+}
+
+unsigned int ProcessExecutor::checkPool()
+{
+    unsigned int fileCount = 0;
+    unsigned int result = 0;
+
+    const std::size_t totalfilesize = std::accumulate(mFiles.cbegin(), mFiles.cend(), std::size_t(0), [](std::size_t v, const FileWithDetails& p) {
+        return v + p.size();
+    });
+
+    // the files are checked in the same order as by check()
+    std::vector<PoolTask> tasks;
+    tasks.reserve(mFileSettings.size() + mFiles.size());
+    for (const FileSettings &fs : mFileSettings)
+        tasks.push_back({nullptr, &fs, fs.filename() + ' ' + fs.cfg, 0});
+    for (const FileWithDetails &file : mFiles)
+        tasks.push_back({&file, nullptr, file.path(), file.size()});
+
+    // a child might terminate before it has read its file, writing to its control pipe must not kill this process
+    struct sigaction ignorePipe{};
+    ignorePipe.sa_handler = SIG_IGN;
+    sigemptyset(&ignorePipe.sa_mask);
+    struct sigaction oldPipe{};
+    sigaction(SIGPIPE, &ignorePipe, &oldPipe);
+
+    std::vector<PoolChild> children;
+    std::size_t nextTask = 0;
+    std::size_t processedsize = 0;
+    for (;;) {
+        // Start the children, a child that has terminated is replaced as long as there are files left
+        std::size_t idle = std::count_if(children.cbegin(), children.cend(), [](const PoolChild &child) {
+            return child.task == noTask && child.control >= 0;
+        });
+        while (children.size() < mSettings.jobs && nextTask + idle < tasks.size()) {
+            int control[2];
+            int results[2];
+            if (pipe(control) == -1 || pipe(results) == -1) {
+                std::cerr << "#### ThreadExecutor::checkPool, pipe() failed: "<< std::strerror(errno) << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+
+            const pid_t pid = fork();
+            if (pid < 0) {
+                // Error
+                std::cerr << "#### ThreadExecutor::checkPool, Failed to create child process: "<< std::strerror(errno) << std::endl;
+                std::exit(EXIT_FAILURE);
+            } else if (pid == 0) {
+#if defined(__linux__)
+                prctl(PR_SET_PDEATHSIG, SIGHUP);
+#endif
+                sigaction(SIGPIPE, &oldPipe, nullptr);
+                close(control[1]);
+                close(results[0]);
+                for (const PoolChild &child : children) {
+                    if (child.control >= 0)
+                        close(child.control);
+                    close(child.results);
+                }
+
+                // every file is checked with the suppressions the child started with
+                const std::list<SuppressionList::Suppression> nomsg = mSuppressions.nomsg.getSuppressions();
+                const std::list<SuppressionList::Suppression> nofail = mSuppressions.nofail.getSuppressions();
+
+                std::uint32_t index = 0;
+                while (readAll(control[0], &index, sizeof(index))) {
+                    Suppressions supprs;
+                    supprs.nomsg.addSuppressions(nomsg);
+                    supprs.nofail.addSuppressions(nofail);
+
+                    PipeWriter pipewriter(results[1]);
+                    CppCheck fileChecker(mSettings, supprs, pipewriter, false, mExecuteCommand);
+                    const PoolTask &task = tasks[index];
+                    unsigned int resultOfCheck = 0;
+                    if (task.fileSettings)
+                        resultOfCheck = fileChecker.check(*task.fileSettings);
+                    else
+                        resultOfCheck = fileChecker.check(*task.file);
+
+                    pipewriter.writeSuppr(supprs.nomsg);
+
+                    pipewriter.writeEnd(std::to_string(resultOfCheck));
+                }
+                std::exit(EXIT_SUCCESS);
+            }
+
+            close(control[0]);
+            close(results[1]);
+            children.push_back({pid, control[1], results[0], std::string(), noTask});
+            ++idle;
+        }
+
+        // Assign the files to the idle children
+        std::size_t busy = children.size() - idle;
+        for (PoolChild &child : children) {
+            if (child.task != noTask || child.control < 0)
+                continue;
+            if (nextTask < tasks.size()) {
+                if (!checkLoadAverage(busy))
+                    break;
+                const auto index = static_cast<std::uint32_t>(nextTask);
+                if (writeAll(child.control, &index, sizeof(index))) {
+                    child.task = nextTask++;
+                    ++busy;
+                    continue;
+                }
+                // the child has terminated, it is handled when its results pipe is closed
+            }
+            // there are no files left, the child terminates when its control pipe is closed
+            close(child.control);
+            child.control = -1;
+        }
+
+        if (children.empty()) {
+            // All done
+            break;
+        }
+
+        std::vector<pollfd> fds;
+        fds.reserve(children.size());
+        for (const PoolChild &child : children)
+            fds.push_back({child.results, POLLIN, 0});
+        // for every second polling of load average condition
+        const int r = poll(fds.data(), fds.size(), 1000);
+        if (r < 0 && errno != EINTR) {
+            std::cerr << "#### ThreadExecutor::checkPool, poll() failed: "<< std::strerror(errno) << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        if (r <= 0)
+            continue;
+
+        for (std::size_t i = fds.size(); i > 0; --i) {
+            if (fds[i - 1].revents == 0)
+                continue;
+            PoolChild &child = children[i - 1];
+            const std::string name = (child.task != noTask) ? tasks[child.task].name : std::string();
+            const ReadResult readRes = handleRead(child.results, child.buffer, result, name);
+            if (readRes == ReadResult::Continue)
+                continue;
+
+            if (readRes == ReadResult::Failure) {
+                // the child has terminated
+                close(child.results);
+                if (child.control >= 0)
+                    close(child.control);
+                int stat = 0;
+                while (waitpid(child.pid, &stat, 0) < 0 && errno == EINTR) {}
+                if (child.task != noTask) {
+                    // need to increment so a crash results in an error exitcode
+                    ++result;
+                    if (WIFEXITED(stat)) {
+                        std::ostringstream oss;
+                        oss << "Child process exited with " << WEXITSTATUS(stat);
+                        reportInternalChildErr(name, oss.str());
+                    } else if (WIFSIGNALED(stat)) {
+                        std::ostringstream oss;
+                        oss << "Child process crashed with signal " << WTERMSIG(stat);
+                        reportInternalChildErr(name, oss.str());
+                    }
+                }
+            }
+
+            if (child.task != noTask) {
+                fileCount++;
+                processedsize += tasks[child.task].size;
+                if (!mSettings.quiet)
+                    Executor::reportStatus(fileCount, tasks.size(), processedsize, totalfilesize);
+                child.task = noTask;
+            }
+
+            if (readRes == ReadResult::Failure)
+                children.erase(children.begin() + (i - 1));
+        }
+    }
+
+    sigaction(SIGPIPE, &oldPipe, nullptr);
+
+    // TODO: wee need to get the timing information from the subprocess
+    if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_SUMMARY || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY)
+        CppCheck::printTimerResults(mSettings.showtime);
+
+    return result;
+}
+
 void ProcessExecutor::reportInternalChildErr(const std::string &childname, const std::string &msg)
 {
     std::list<ErrorMessage::FileLocation> locations;
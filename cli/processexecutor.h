@@ -23,6 +23,7 @@
 #include "executor.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <list>
 #include <string>
 
@@ -48,11 +49,26 @@ public:
     unsigned int check() override;
 
 private:
+    /**
+     * Check the files with --process-pool: the child processes are forked once and receive the
+     * files over a pipe. A child that crashes is replaced.
+     */
+    unsigned int checkPool();
+
+    enum class ReadResult : std::uint8_t { Continue, ChildEnd, Failure };
+
     /**
      * Read from the pipe, parse and handle what ever is in there.
-     * @return False in case of an recoverable error - will exit process on others
+     * @param buffer data of the pipe that has not been handled yet
+     * @return ChildEnd when the child has finished the file, Failure when the pipe was closed or in case of an recoverable error - will exit process on others
+     */
+    ReadResult handleRead(int rpipe, std::string &buffer, unsigned int &result, const std::string& filename);
+
+    /**
+     * Handle a message from a child.
+     * @return False if the child has finished
      */
-    bool handleRead(int rpipe, unsigned int &result, const std::string& filename);
+    bool handleMessage(char type, const std::string &buf, unsigned int &result, const std::string& filename);
 
     /**
      * @brief Check load average condition
@@ -18,6 +18,7 @@
 
 #include "threadexecutor.h"
 
+#include "analyzerinfo.h"
 #include "config.h"
 #include "cppcheck.h"
 #include "errorlogger.h"
@@ -26,11 +27,17 @@
 #include "suppressions.h"
 #include "timer.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <deque>
 #include <future>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <map>
 #include <numeric>
 #include <mutex>
 #include <string>
@@ -81,35 +88,52 @@ class ThreadData
 {
 public:
     ThreadData(ThreadExecutor &threadExecutor, ErrorLogger &errorLogger, const Settings &settings, Suppressions& supprs, const std::list<FileWithDetails> &files, const std::list<FileSettings> &fileSettings, CppCheck::ExecuteCmdFn executeCommand)
-        : mFiles(files), mFileSettings(fileSettings), mSettings(settings), mSuppressions(supprs), mExecuteCommand(std::move(executeCommand)), logForwarder(threadExecutor, errorLogger)
+        : mSettings(settings), mSuppressions(supprs), mExecuteCommand(std::move(executeCommand)), mQueues(settings.jobs), logForwarder(threadExecutor, errorLogger)
     {
-        mItNextFile = mFiles.begin();
-        mItNextFileSettings = mFileSettings.begin();
-
-        mTotalFiles = mFiles.size() + mFileSettings.size();
-        mTotalFileSize = std::accumulate(mFiles.cbegin(), mFiles.cend(), std::size_t(0), [](std::size_t v, const FileWithDetails& p) {
+        mTotalFiles = files.size() + fileSettings.size();
+        mTotalFileSize = std::accumulate(files.cbegin(), files.cend(), std::size_t(0), [](std::size_t v, const FileWithDetails& p) {
             return v + p.size();
         });
+
+        schedule(files, fileSettings);
     }
 
-    bool next(const FileWithDetails *&file, const FileSettings *&fs, std::size_t &fileSize) {
-        std::lock_guard<std::mutex> l(mFileSync);
-        if (mItNextFile != mFiles.end()) {
-            file = &(*mItNextFile);
-            fs = nullptr;
-            fileSize = mItNextFile->size();
-            ++mItNextFile;
-            return true;
+    bool next(unsigned int worker, const FileWithDetails *&file, const FileSettings *&fs, std::size_t &fileSize) {
+        {
+            WorkQueue &own = mQueues[worker];
+            std::lock_guard<std::mutex> l(own.sync);
+            if (!own.items.empty()) {
+                take(own.items.front(), file, fs, fileSize);
+                own.items.pop_front();
+                return true;
+            }
         }
-        if (mItNextFileSettings != mFileSettings.end()) {
-            file = nullptr;
-            fs = &(*mItNextFileSettings);
-            fileSize = 0;
-            ++mItNextFileSettings;
+
+        // own queue is drained - steal the most expensive pending file from another worker
+        for (;;) {
+            std::size_t victim = mQueues.size();
+            std::size_t victimCost = 0;
+            for (std::size_t i = 0; i < mQueues.size(); ++i) {
+                if (i == worker)
+                    continue;
+                std::lock_guard<std::mutex> l(mQueues[i].sync);
+                if (!mQueues[i].items.empty() && (victim == mQueues.size() || mQueues[i].items.front().cost > victimCost)) {
+                    victim = i;
+                    victimCost = mQueues[i].items.front().cost;
+                }
+            }
+            if (victim == mQueues.size())
+                return false;
+
+            WorkQueue &other = mQueues[victim];
+            std::lock_guard<std::mutex> l(other.sync);
+            // the victim might have emptied its queue in the meantime
+            if (other.items.empty())
+                continue;
+            take(other.items.front(), file, fs, fileSize);
+            other.items.pop_front();
             return true;
         }
-
-        return false;
     }
 
     unsigned int check(ErrorLogger &errorLogger, const FileWithDetails *file, const FileSettings *fs) const {
@@ -151,11 +175,95 @@ public:
             logForwarder.reportStatus(mProcessedFiles, mTotalFiles, mProcessedSize, mTotalFileSize);
     }
 
+    void fileTime(const FileWithDetails *file, const FileSettings *fs, std::size_t elapsedMs) {
+        if (mSettings.buildDir.empty())
+            return;
+        std::lock_guard<std::mutex> l(mFileSync);
+        mFileTimes[getFileTimesKey(file, fs)] = elapsedMs;
+    }
+
+    const std::map<std::string, std::size_t>& fileTimes() const {
+        return mFileTimes;
+    }
+
 private:
-    const std::list<FileWithDetails> &mFiles;
-    std::list<FileWithDetails>::const_iterator mItNextFile;
-    const std::list<FileSettings> &mFileSettings;
-    std::list<FileSettings>::const_iterator mItNextFileSettings;
+    struct WorkItem {
+        const FileWithDetails *file;
+        const FileSettings *fs;
+        std::size_t cost;
+    };
+
+    struct WorkQueue {
+        std::mutex sync;
+        std::deque<WorkItem> items;
+    };
+
+    static std::string getFileTimesKey(const FileWithDetails *file, const FileSettings *fs) {
+        if (fs)
+            return AnalyzerInformation::getFileTimesKey(fs->filename(), fs->cfg, fs->fileIndex);
+        return AnalyzerInformation::getFileTimesKey(file->path(), "", 0);
+    }
+
+    static void take(const WorkItem &item, const FileWithDetails *&file, const FileSettings *&fs, std::size_t &fileSize) {
+        file = item.file;
+        fs = item.fs;
+        fileSize = fs ? 0 : file->size();
+    }
+
+    /**
+     * Distribute the files over the per-worker queues, most expensive first.
+     * The cost is the analysis time of the previous run (from the build dir) when
+     * known, otherwise the file size scaled to the same unit.
+     */
+    void schedule(const std::list<FileWithDetails> &files, const std::list<FileSettings> &fileSettings) {
+        std::vector<WorkItem> items;
+        items.reserve(mTotalFiles);
+        for (const FileWithDetails &f : files)
+            items.push_back({&f, nullptr, f.size()});
+        for (const FileSettings &fs : fileSettings)
+            items.push_back({nullptr, &fs, fs.file.size()});
+
+        if (!mSettings.buildDir.empty()) {
+            const std::map<std::string, std::size_t> prevTimes = AnalyzerInformation::readFileTimes(mSettings.buildDir);
+            if (!prevTimes.empty()) {
+                // find out the previous times and how many bytes were analysed per millisecond
+                std::vector<std::size_t> times(items.size(), SIZE_MAX);
+                std::size_t timedSize = 0;
+                std::size_t timedMs = 0;
+                std::size_t timedCount = 0;
+                for (std::size_t i = 0; i < items.size(); ++i) {
+                    const auto it = prevTimes.find(getFileTimesKey(items[i].file, items[i].fs));
+                    if (it == prevTimes.cend())
+                        continue;
+                    times[i] = it->second;
+                    timedSize += items[i].cost;
+                    timedMs += it->second;
+                    ++timedCount;
+                }
+                const std::size_t bytesPerMs = (timedSize > 0 && timedMs > 0) ? std::max<std::size_t>(1, timedSize / timedMs) : 1;
+                const std::size_t averageCost = timedCount > 0 ? (timedMs / timedCount) * bytesPerMs : 0;
+                for (std::size_t i = 0; i < items.size(); ++i) {
+                    if (times[i] != SIZE_MAX)
+                        items[i].cost = times[i] * bytesPerMs;
+                    else if (items[i].cost == 0)
+                        items[i].cost = averageCost;
+                }
+            }
+        }
+
+        // keep the original order for files with identical costs so the scheduling is reproducible
+        std::stable_sort(items.begin(), items.end(), [](const WorkItem &a, const WorkItem &b) {
+            return a.cost > b.cost;
+        });
+
+        // assign each file to the least loaded worker - every queue stays sorted by cost
+        std::vector<std::size_t> load(mQueues.size(), 0);
+        for (const WorkItem &item : items) {
+            const std::size_t worker = std::distance(load.cbegin(), std::min_element(load.cbegin(), load.cend()));
+            load[worker] += std::max<std::size_t>(1, item.cost);
+            mQueues[worker].items.push_back(item);
+        }
+    }
 
     std::size_t mProcessedFiles{};
     std::size_t mTotalFiles{};
@@ -167,11 +275,14 @@ private:
     Suppressions &mSuppressions;
     CppCheck::ExecuteCmdFn mExecuteCommand;
 
+    std::vector<WorkQueue> mQueues;
+    std::map<std::string, std::size_t> mFileTimes;
+
 public:
     SyncLogForwarder logForwarder;
 };
 
-static unsigned int STDCALL threadProc(ThreadData *data)
+static unsigned int STDCALL threadProc(ThreadData *data, unsigned int worker)
 {
     unsigned int result = 0;
 
@@ -179,9 +290,13 @@ static unsigned int STDCALL threadProc(ThreadData *data)
     const FileSettings *fs;
     std::size_t fileSize;
 
-    while (data->next(file, fs, fileSize)) {
+    while (data->next(worker, file, fs, fileSize)) {
+        const auto start = std::chrono::steady_clock::now();
+
         result += data->check(data->logForwarder, file, fs);
 
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        data->fileTime(file, fs, elapsed.count());
         data->status(fileSize);
     }
 
@@ -197,7 +312,7 @@ unsigned int ThreadExecutor::check()
 
     for (unsigned int i = 0; i < mSettings.jobs; ++i) {
         try {
-            threadFutures.emplace_back(std::async(std::launch::async, &threadProc, &data));
+            threadFutures.emplace_back(std::async(std::launch::async, &threadProc, &data, i));
         }
         catch (const std::system_error &e) {
             std::cerr << "#### ThreadExecutor::check exception :" << e.what() << std::endl;
@@ -209,6 +324,9 @@ unsigned int ThreadExecutor::check()
         return v + f.get();
     });
 
+    if (!mSettings.buildDir.empty())
+        AnalyzerInformation::writeFileTimes(mSettings.buildDir, data.fileTimes());
+
     if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_SUMMARY || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY)
         CppCheck::printTimerResults(mSettings.showtime);
 
@@ -36,6 +36,11 @@ class FileWithDetails;
 /**
  * This class will take a list of filenames and settings and check then
  * all files using threads.
+ *
+ * The files are checked largest first - the cost is estimated from the file size
+ * or from the time recorded in the build dir by a previous run. Each thread
+ * has its own queue and takes over pending files from other threads once it
+ * is drained.
  */
 class ThreadExecutor : public Executor {
     friend class SyncLogForwarder;
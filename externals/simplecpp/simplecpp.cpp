@@ -3177,7 +3177,14 @@ static bool hasFile(const std::map<std::string, simplecpp::TokenList *> &filedat
     return !getFileName(filedata, sourcefile, header, dui, systemheader).empty();
 }
 
-std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::TokenList &rawtokens, std::vector<std::string> &filenames, const simplecpp::DUI &dui, simplecpp::OutputList *outputList)
+static simplecpp::TokenList *loadFile(const std::string &filename, std::vector<std::string> &filenames, simplecpp::OutputList *outputList, simplecpp::FileLoader *fileLoader)
+{
+    if (fileLoader)
+        return fileLoader->load(filename, filenames, outputList);
+    return new simplecpp::TokenList(filename, filenames, outputList);
+}
+
+std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::TokenList &rawtokens, std::vector<std::string> &filenames, const simplecpp::DUI &dui, simplecpp::OutputList *outputList, simplecpp::FileLoader *fileLoader)
 {
 #ifdef SIMPLECPP_WINDOWS
     if (dui.clearIncludeCache)
@@ -3208,7 +3215,7 @@ std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::To
         }
         fin.close();
 
-        TokenList *tokenlist = new TokenList(filename, filenames, outputList);
+        TokenList *tokenlist = loadFile(filename, filenames, outputList, fileLoader);
         if (!tokenlist->front()) {
             delete tokenlist;
             continue;
@@ -3250,7 +3257,7 @@ std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::To
             continue;
         f.close();
 
-        TokenList *tokens = new TokenList(header2, filenames, outputList);
+        TokenList *tokens = loadFile(header2, filenames, outputList, fileLoader);
         if (dui.removeComments)
             tokens->removeComments();
         ret[header2] = tokens;
@@ -347,9 +347,21 @@ namespace simplecpp {
         bool removeComments; /** remove comment tokens from included files */
     };
 
+    /**
+     * Creates the raw tokens of the files loaded by simplecpp::load().
+     * This can be used to reuse the tokens of headers that are included in many files.
+     */
+    class SIMPLECPP_LIB FileLoader {
+    public:
+        virtual ~FileLoader() {}
+
+        /** tokenize file. the returned TokenList is owned by the caller */
+        virtual TokenList *load(const std::string &filename, std::vector<std::string> &filenames, OutputList *outputList) = 0;
+    };
+
     SIMPLECPP_LIB long long characterLiteralToLL(const std::string& str);
 
-    SIMPLECPP_LIB std::map<std::string, TokenList*> load(const TokenList &rawtokens, std::vector<std::string> &filenames, const DUI &dui, OutputList *outputList = nullptr);
+    SIMPLECPP_LIB std::map<std::string, TokenList*> load(const TokenList &rawtokens, std::vector<std::string> &filenames, const DUI &dui, OutputList *outputList = nullptr, FileLoader *fileLoader = nullptr);
 
     /**
      * Preprocess
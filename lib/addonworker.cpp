@@ -0,0 +1,212 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "addonworker.h"
+
+#include "utils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+AddonWorker::AddonWorker(std::string exe, std::vector<std::string> args)
+    : mExe(std::move(exe))
+    , mArgs(std::move(args))
+{}
+
+AddonWorker::~AddonWorker()
+{
+    stop();
+}
+
+int AddonWorker::parseExitCode(const std::string &line)
+{
+    static const std::string prefix = "{\"exitcode\": ";
+    if (!startsWith(line, prefix) || line.back() != '}')
+        return -1;
+    const std::string value = line.substr(prefix.size(), line.size() - prefix.size() - 1);
+    if (value.empty() || value.size() > 9 || !std::all_of(value.cbegin(), value.cend(), [](char c) {
+        return std::isdigit(static_cast<unsigned char>(c));
+    }))
+        return -1;
+    return std::stoi(value);
+}
+
+#ifdef _WIN32
+
+// TODO: implement with CreateProcess() and named pipes
+bool AddonWorker::start()
+{
+    return false;
+}
+
+int AddonWorker::stop()
+{
+    return -1;
+}
+
+bool AddonWorker::execute(const std::string & /*request*/, std::string & /*output*/, int & /*exitcode*/)
+{
+    return false;
+}
+
+#else
+
+#ifdef MSG_NOSIGNAL
+static constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+static constexpr int sendFlags = 0;
+#endif
+
+bool AddonWorker::start()
+{
+    int type = SOCK_STREAM;
+#ifdef SOCK_CLOEXEC
+    type |= SOCK_CLOEXEC;
+#endif
+    int fds[2];
+    if (socketpair(AF_UNIX, type, 0, fds) != 0)
+        return false;
+#ifndef SOCK_CLOEXEC
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+#ifdef SO_NOSIGPIPE
+    const int on = 1;
+    setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+    // prepare the arguments before forking, only async-signal-safe calls are allowed in the child
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(mExe.c_str()));
+    for (const std::string &arg : mArgs)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        // the requests are read from stdin, stderr is redirected like with "2>&1"
+        dup2(fds[1], STDIN_FILENO);
+        dup2(fds[1], STDOUT_FILENO);
+        dup2(fds[1], STDERR_FILENO);
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+    close(fds[1]);
+    mPid = pid;
+    mOwner = getpid();
+    mFd = fds[0];
+    mBuffer.clear();
+    return true;
+}
+
+int AddonWorker::stop()
+{
+    if (mFd < 0)
+        return -1;
+    close(mFd);
+    mFd = -1;
+    int status = -1;
+    if (mOwner == getpid()) {
+        while (waitpid(mPid, &status, 0) < 0) {
+            if (errno != EINTR) {
+                status = -1;
+                break;
+            }
+        }
+    }
+    mPid = -1;
+    if (status == -1)
+        return -1;
+    if (WIFEXITED(status))
+        return WEXITSTATUS(status);
+    if (WIFSIGNALED(status))
+        return WTERMSIG(status);
+    return status;
+}
+
+bool AddonWorker::execute(const std::string &request, std::string &output, int &exitcode)
+{
+    if (mFd >= 0 && mOwner != getpid()) {
+        // the worker belongs to the parent process
+        close(mFd);
+        mFd = -1;
+    }
+    if (mFd < 0 && !start())
+        return false;
+
+    const std::string line = request + '\n';
+    for (std::size_t pos = 0; pos < line.size();) {
+        const ssize_t n = send(mFd, line.data() + pos, line.size() - pos, sendFlags);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            // the worker has terminated
+            exitcode = stop();
+            return true;
+        }
+        pos += n;
+    }
+
+    for (;;) {
+        std::string::size_type begin = 0;
+        for (std::string::size_type end = mBuffer.find('\n'); end != std::string::npos; end = mBuffer.find('\n', begin)) {
+            const std::string outputLine = mBuffer.substr(begin, end - begin);
+            begin = end + 1;
+            const int code = parseExitCode(outputLine);
+            if (code >= 0) {
+                mBuffer.erase(0, begin);
+                exitcode = code;
+                return true;
+            }
+            output += outputLine;
+            output += '\n';
+        }
+        mBuffer.erase(0, begin);
+
+        char buf[4096];
+        const ssize_t n = recv(mFd, buf, sizeof(buf), 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            // the worker has terminated without finishing the request
+            output += mBuffer;
+            mBuffer.clear();
+            exitcode = stop();
+            return true;
+        }
+        mBuffer.append(buf, n);
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef addonworkerH
+#define addonworkerH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <string>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief A long-lived addon process.
+ *
+ * The addon is started once in server mode and reads one request per line from its standard
+ * input. It writes the JSON results of each request to its standard output, followed by a
+ * JSON line with the exit code of the request.
+ */
+class CPPCHECKLIB AddonWorker {
+public:
+    AddonWorker(std::string exe, std::vector<std::string> args);
+    ~AddonWorker();
+
+    AddonWorker(const AddonWorker &) = delete;
+    AddonWorker &operator=(const AddonWorker &) = delete;
+
+    /**
+     * Send a request to the worker and wait until it has been processed. The worker is started
+     * if it is not running.
+     * @param request the request line
+     * @param output the output of the request
+     * @param exitcode the exit code of the request, the exit status of the worker if it terminated
+     * @return false if the worker could not be started
+     */
+    bool execute(const std::string &request, std::string &output, int &exitcode);
+
+    /** @return exit code of the request if the line terminates the output of a request, otherwise -1 */
+    static int parseExitCode(const std::string &line);
+
+private:
+    bool start();
+    /** close the connection to the worker and wait until it terminated, @return its exit status */
+    int stop();
+
+    const std::string mExe;
+    const std::vector<std::string> mArgs;
+    int mPid{-1};
+    /** process that started the worker, a forked process starts its own */
+    int mOwner{-1};
+    int mFd{-1};
+    /** output that has been received but does not belong to a finished request yet */
+    std::string mBuffer;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // addonworkerH
@@ -19,16 +19,117 @@
 #include "analyzerinfo.h"
 
 #include "errorlogger.h"
+#include "errortypes.h"
 #include "filesettings.h"
 #include "path.h"
 #include "utils.h"
 
+#include <cstdint>
 #include <cstring>
 #include <map>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "xml.h"
 
+namespace {
+    namespace BinaryFile {
+        constexpr char magic[] = "cppcheck-analyzerinfo";
+        constexpr std::uint32_t version = 1;
+
+        enum Record : std::uint8_t {
+            end = 0,
+            error = 1,
+            fileInfo = 2
+        };
+
+        struct Data {
+            std::uint64_t hash{};
+            /** serialized error messages */
+            std::vector<std::string> errors;
+            /** check name and XML data of the whole program analysis */
+            std::vector<std::pair<std::string, std::string>> fileInfo;
+        };
+
+        enum class Result : std::uint8_t {
+            ok,
+            invalid,
+            notBinary
+        };
+
+        template<class T>
+        void writeValue(std::ostream &out, T value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+
+        void writeString(std::ostream &out, const std::string &str)
+        {
+            writeValue<std::uint32_t>(out, str.size());
+            out.write(str.data(), str.size());
+        }
+
+        template<class T>
+        bool readValue(std::istream &in, T &value)
+        {
+            return !!in.read(reinterpret_cast<char *>(&value), sizeof(value));
+        }
+
+        bool readString(std::istream &in, std::string &str)
+        {
+            std::uint32_t len;
+            if (!readValue(in, len))
+                return false;
+            str.resize(len);
+            return !!in.read(&str[0], len);
+        }
+
+        bool readMagic(std::istream &in)
+        {
+            char buf[sizeof(magic)];
+            return in.read(buf, sizeof(buf)) && std::memcmp(buf, magic, sizeof(magic)) == 0;
+        }
+
+        Result read(const std::string &filename, Data &data)
+        {
+            std::ifstream fin(filename, std::ios::binary);
+            if (!fin.is_open())
+                return Result::invalid;
+            if (!readMagic(fin))
+                return Result::notBinary;
+
+            std::uint32_t v;
+            if (!readValue(fin, v) || v != version || !readValue(fin, data.hash))
+                return Result::invalid;
+
+            for (;;) {
+                std::uint8_t record;
+                if (!readValue(fin, record))
+                    return Result::invalid;
+                if (record == Record::end)
+                    break;
+                if (record == Record::error) {
+                    std::string msg;
+                    if (!readString(fin, msg))
+                        return Result::invalid;
+                    data.errors.push_back(std::move(msg));
+                } else if (record == Record::fileInfo) {
+                    std::string check, info;
+                    if (!readString(fin, check) || !readString(fin, info))
+                        return Result::invalid;
+                    data.fileInfo.emplace_back(std::move(check), std::move(info));
+                } else {
+                    return Result::invalid;
+                }
+            }
+
+            // a file without the trailing magic was not completely written
+            return readMagic(fin) ? Result::ok : Result::invalid;
+        }
+    }
+}
+
 AnalyzerInformation::~AnalyzerInformation()
 {
     close();
@@ -78,13 +179,41 @@ void AnalyzerInformation::close()
 {
     mAnalyzerInfoFile.clear();
     if (mOutputStream.is_open()) {
-        mOutputStream << "</analyzerinfo>\n";
+        if (mXml) {
+            mOutputStream << "</analyzerinfo>\n";
+        } else {
+            BinaryFile::writeValue<std::uint8_t>(mOutputStream, BinaryFile::Record::end);
+            mOutputStream.write(BinaryFile::magic, sizeof(BinaryFile::magic));
+        }
         mOutputStream.close();
     }
 }
 
 static bool skipAnalysis(const std::string &analyzerInfoFile, std::size_t hash, std::list<ErrorMessage> &errors)
 {
+    BinaryFile::Data data;
+    switch (BinaryFile::read(analyzerInfoFile, data)) {
+    case BinaryFile::Result::ok: {
+        if (data.hash != hash)
+            return false;
+        std::list<ErrorMessage> msgs;
+        try {
+            for (const std::string &e : data.errors) {
+                msgs.emplace_back();
+                msgs.back().deserialize(e);
+            }
+        } catch (const InternalError &) {
+            return false;
+        }
+        errors.splice(errors.end(), msgs);
+        return true;
+    }
+    case BinaryFile::Result::invalid:
+        return false;
+    case BinaryFile::Result::notBinary:
+        break;
+    }
+
     tinyxml2::XMLDocument doc;
     const tinyxml2::XMLError error = doc.LoadFile(analyzerInfoFile.c_str());
     if (error != tinyxml2::XML_SUCCESS)
@@ -150,27 +279,135 @@ bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::st
     if (skipAnalysis(mAnalyzerInfoFile, hash, errors))
         return false;
 
-    mOutputStream.open(mAnalyzerInfoFile);
-    if (mOutputStream.is_open()) {
+    mOutputStream.open(mAnalyzerInfoFile, mXml ? std::ios::out : (std::ios::out | std::ios::binary));
+    if (!mOutputStream.is_open()) {
+        mAnalyzerInfoFile.clear();
+    } else if (mXml) {
         mOutputStream << "<?xml version=\"1.0\"?>\n";
         mOutputStream << "<analyzerinfo hash=\"" << hash << "\">\n";
     } else {
-        mAnalyzerInfoFile.clear();
+        mOutputStream.write(BinaryFile::magic, sizeof(BinaryFile::magic));
+        BinaryFile::writeValue(mOutputStream, BinaryFile::version);
+        BinaryFile::writeValue<std::uint64_t>(mOutputStream, hash);
     }
 
     return true;
 }
 
+bool AnalyzerInformation::readFileInfo(const std::string &analyzerInfoFile,
+                                       const std::set<std::string> &checks,
+                                       const std::function<void(const std::string &check, const tinyxml2::XMLElement *fileInfo)> &f)
+{
+    BinaryFile::Data data;
+    switch (BinaryFile::read(analyzerInfoFile, data)) {
+    case BinaryFile::Result::ok:
+        for (const auto &fileInfo : data.fileInfo) {
+            if (!checks.empty() && checks.count(fileInfo.first) == 0)
+                continue;
+            // only the data of the requested checks is parsed
+            const std::string xml = "<FileInfo check=\"" + fileInfo.first + "\">" + fileInfo.second + "</FileInfo>";
+            tinyxml2::XMLDocument doc;
+            if (doc.Parse(xml.c_str(), xml.size()) != tinyxml2::XML_SUCCESS)
+                continue;
+            f(fileInfo.first, doc.FirstChildElement());
+        }
+        return true;
+    case BinaryFile::Result::invalid:
+        return false;
+    case BinaryFile::Result::notBinary:
+        break;
+    }
+
+    tinyxml2::XMLDocument doc;
+    const tinyxml2::XMLError error = doc.LoadFile(analyzerInfoFile.c_str());
+    if (error != tinyxml2::XML_SUCCESS)
+        return false;
+
+    const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
+    if (rootNode == nullptr)
+        return false;
+
+    for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
+        if (std::strcmp(e->Name(), "FileInfo") != 0)
+            continue;
+        const char *checkAttr = e->Attribute("check");
+        if (!checkAttr)
+            continue;
+        const std::string check = checkAttr;
+        if (!checks.empty() && checks.count(check) == 0)
+            continue;
+        f(check, e);
+    }
+    return true;
+}
+
 void AnalyzerInformation::reportErr(const ErrorMessage &msg)
 {
-    if (mOutputStream.is_open())
+    if (!mOutputStream.is_open())
+        return;
+    if (mXml) {
         mOutputStream << msg.toXML() << '\n';
+    } else {
+        BinaryFile::writeValue<std::uint8_t>(mOutputStream, BinaryFile::Record::error);
+        BinaryFile::writeString(mOutputStream, msg.serialize());
+    }
 }
 
 void AnalyzerInformation::setFileInfo(const std::string &check, const std::string &fileInfo)
 {
-    if (mOutputStream.is_open() && !fileInfo.empty())
+    if (!mOutputStream.is_open() || fileInfo.empty())
+        return;
+    if (mXml) {
         mOutputStream << "  <FileInfo check=\"" << check << "\">\n" << fileInfo << "  </FileInfo>\n";
+    } else {
+        BinaryFile::writeValue<std::uint8_t>(mOutputStream, BinaryFile::Record::fileInfo);
+        BinaryFile::writeString(mOutputStream, check);
+        BinaryFile::writeString(mOutputStream, fileInfo);
+    }
+}
+
+std::string AnalyzerInformation::getFileTimesKey(const std::string &sourcefile, const std::string &cfg, int fileIndex)
+{
+    const std::string id = (fileIndex > 0) ? std::to_string(fileIndex) : "";
+    return cfg + sep + id + sep + Path::simplifyPath(sourcefile);
+}
+
+std::map<std::string, std::size_t> AnalyzerInformation::parseFileTimes(std::istream& fileTimesTxt)
+{
+    std::map<std::string, std::size_t> fileTimes;
+    std::string line;
+    while (std::getline(fileTimesTxt, line)) {
+        const std::string::size_type pos = line.find(sep);
+        if (pos == std::string::npos || pos == 0)
+            continue;
+        try {
+            const std::size_t ms = std::stoul(line.substr(0, pos));
+            fileTimes[line.substr(pos + 1)] = ms;
+        } catch (const std::exception&) {
+            // ignore corrupt lines
+        }
+    }
+    return fileTimes;
+}
+
+std::map<std::string, std::size_t> AnalyzerInformation::readFileTimes(const std::string &buildDir)
+{
+    std::ifstream fin(Path::join(buildDir, "filetimes.txt"));
+    if (!fin.is_open())
+        return {};
+    return parseFileTimes(fin);
+}
+
+void AnalyzerInformation::writeFileTimes(const std::string &buildDir, const std::map<std::string, std::size_t> &fileTimes)
+{
+    // keep the times of files which were not analyzed in this run
+    std::map<std::string, std::size_t> merged = readFileTimes(buildDir);
+    for (const auto& t : fileTimes)
+        merged[t.first] = t.second;
+
+    std::ofstream fout(Path::join(buildDir, "filetimes.txt"));
+    for (const auto& t : merged)
+        fout << t.second << sep << t.first << '\n';
 }
 
 bool AnalyzerInformation::Info::parse(const std::string& filesTxtLine) {
@@ -25,11 +25,18 @@
 
 #include <cstddef>
 #include <fstream>
+#include <functional>
+#include <iosfwd>
 #include <list>
+#include <map>
+#include <set>
 #include <string>
 
 class ErrorMessage;
 struct FileSettings;
+namespace tinyxml2 {
+    class XMLElement;
+}
 
 /// @addtogroup Core
 /// @{
@@ -46,9 +53,14 @@ struct FileSettings;
  * - 'make' - only analyze TUs that are changed and generate full report
  * - should be possible to add distributed analysis later
  * - multi-threaded whole program analysis
+ *
+ * The information is stored in a compact binary format by default, the XML
+ * format can still be written for external tools.
  */
 class CPPCHECKLIB AnalyzerInformation {
 public:
+    /** @param xml write the information as XML instead of the binary format */
+    explicit AnalyzerInformation(bool xml = false) : mXml(xml) {}
     ~AnalyzerInformation();
 
     static std::string getFilesTxt(const std::list<std::string> &sourcefiles, const std::string &userDefines, const std::list<FileSettings> &fileSettings);
@@ -62,6 +74,26 @@ public:
     void setFileInfo(const std::string &check, const std::string &fileInfo);
     static std::string getAnalyzerInfoFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, int fileIndex);
 
+    /**
+     * Read the whole program analysis data of an analyzer information file in either format
+     * @param analyzerInfoFile the analyzer information file
+     * @param checks the checks whose data is read, the data of all checks is read when empty
+     * @param f called with the check name and the FileInfo element of each check
+     * @return false if the file could not be read
+     */
+    static bool readFileInfo(const std::string &analyzerInfoFile,
+                             const std::set<std::string> &checks,
+                             const std::function<void(const std::string &check, const tinyxml2::XMLElement *fileInfo)> &f);
+
+    /** key used in the analysis time table - matches the trailing part of a files.txt line */
+    static std::string getFileTimesKey(const std::string &sourcefile, const std::string &cfg, int fileIndex);
+
+    /** Read the analysis times (in milliseconds) recorded by a previous run in the build dir */
+    static std::map<std::string, std::size_t> readFileTimes(const std::string &buildDir);
+
+    /** Merge the given analysis times (in milliseconds) into the table stored in the build dir */
+    static void writeFileTimes(const std::string &buildDir, const std::map<std::string, std::size_t> &fileTimes);
+
     static const char sep = ':';
 
     class CPPCHECKLIB Info {
@@ -75,9 +107,11 @@ public:
 
 protected:
     static std::string getAnalyzerInfoFileFromFilesTxt(std::istream& filesTxt, const std::string &sourcefile, const std::string &cfg, int fileIndex);
+    static std::map<std::string, std::size_t> parseFileTimes(std::istream& fileTimesTxt);
 private:
     std::ofstream mOutputStream;
     std::string mAnalyzerInfoFile;
+    bool mXml;
 };
 
 /// @}
@@ -1359,7 +1359,7 @@ CheckIO::ArgumentInfo::ArgumentInfo(const Token * arg, const Settings &settings,
             top = top->astParent();
         const ValueType *valuetype = top->argumentType();
         if (valuetype && valuetype->type >= ValueType::Type::BOOL) {
-            typeToken = tempToken = new Token(top);
+            typeToken = tempToken = Token::create(top);
             if (valuetype->pointer && valuetype->constness & 1) {
                 tempToken->str("const");
                 tempToken->insertToken("a");
@@ -1441,7 +1441,7 @@ CheckIO::ArgumentInfo::ArgumentInfo(const Token * arg, const Settings &settings,
                             if (function->retType->classScope->enumType)
                                 typeToken = function->retType->classScope->enumType;
                             else {
-                                tempToken = new Token(tok1);
+                                tempToken = Token::create(tok1);
                                 tempToken->str("int");
                                 typeToken = tempToken;
                             }
@@ -1460,7 +1460,7 @@ CheckIO::ArgumentInfo::ArgumentInfo(const Token * arg, const Settings &settings,
                         if (function->retType->classScope->enumType)
                             typeToken = function->retType->classScope->enumType;
                         else {
-                            tempToken = new Token(tok1);
+                            tempToken = Token::create(tok1);
                             tempToken->str("int");
                             typeToken = tempToken;
                         }
@@ -1484,7 +1484,7 @@ CheckIO::ArgumentInfo::ArgumentInfo(const Token * arg, const Settings &settings,
             // check for some common well known functions
             else if (isCPP && ((Token::Match(tok1->previous(), "%var% . size|empty|c_str ( ) [,)]") && isStdContainer(tok1->previous())) ||
                                (Token::Match(tok1->previous(), "] . size|empty|c_str ( ) [,)]") && isStdContainer(tok1->linkAt(-1)->previous())))) {
-                tempToken = new Token(tok1);
+                tempToken = Token::create(tok1);
                 if (tok1->strAt(1) == "size") {
                     // size_t is platform dependent
                     if (settings.platform.sizeof_size_t == 8) {
@@ -1543,7 +1543,7 @@ CheckIO::ArgumentInfo::ArgumentInfo(const Token * arg, const Settings &settings,
                     if (variableInfo->type() && variableInfo->type()->classScope && variableInfo->type()->classScope->enumType)
                         typeToken = variableInfo->type()->classScope->enumType;
                     else {
-                        tempToken = new Token(tok1);
+                        tempToken = Token::create(tok1);
                         tempToken->str("int");
                         typeToken = tempToken;
                     }
@@ -1581,7 +1581,7 @@ bool CheckIO::ArgumentInfo::isStdVectorOrString()
         return true;
     }
     if (variableInfo->isStlType(stl_string)) {
-        tempToken = new Token(variableInfo->typeStartToken());
+        tempToken = Token::create(variableInfo->typeStartToken());
         if (variableInfo->typeStartToken()->strAt(2) == "string")
             tempToken->str("char");
         else
@@ -1599,7 +1599,7 @@ bool CheckIO::ArgumentInfo::isStdVectorOrString()
                 return true;
             }
             if (Token::Match(nameTok, "std :: string|wstring")) {
-                tempToken = new Token(variableInfo->typeStartToken());
+                tempToken = Token::create(variableInfo->typeStartToken());
                 if (nameTok->strAt(2) == "string")
                     tempToken->str("char");
                 else
@@ -653,7 +653,7 @@ bool CheckNullPointer::analyseWholeProgram(const CTU::FileInfo &ctu, const std::
     if (fileInfo.empty())
         return false;
 
-    const std::map<std::string, std::list<const CTU::FileInfo::CallBase *>> callsMap = ctu.getCallsMap();
+    const std::map<std::string, std::list<const CTU::FileInfo::CallBase *>> &callsMap = ctu.getCallsMap();
 
     bool foundErrors = false;
 
@@ -1760,7 +1760,7 @@ bool CheckUninitVar::analyseWholeProgram(const CTU::FileInfo &ctu, const std::li
     if (fileInfo.empty())
         return false;
 
-    const std::map<std::string, std::list<const CTU::FileInfo::CallBase *>> callsMap = ctu.getCallsMap();
+    const std::map<std::string, std::list<const CTU::FileInfo::CallBase *>> &callsMap = ctu.getCallsMap();
 
     bool foundErrors = false;
 
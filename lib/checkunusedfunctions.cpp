@@ -20,6 +20,7 @@
 //---------------------------------------------------------------------------
 #include "checkunusedfunctions.h"
 
+#include "analyzerinfo.h"
 #include "astutils.h"
 #include "errorlogger.h"
 #include "errortypes.h"
@@ -459,24 +460,10 @@ void CheckUnusedFunctions::analyseWholeProgram(const Settings &settings, ErrorLo
         const std::string::size_type secondColon = filesTxtLine.find(':', firstColon+1);
         if (secondColon == std::string::npos)
             continue;
-        const std::string xmlfile = buildDir + '/' + filesTxtLine.substr(0,firstColon);
+        const std::string analyzerInfoFile = buildDir + '/' + filesTxtLine.substr(0,firstColon);
         const std::string sourcefile = filesTxtLine.substr(secondColon+1);
 
-        tinyxml2::XMLDocument doc;
-        const tinyxml2::XMLError error = doc.LoadFile(xmlfile.c_str());
-        if (error != tinyxml2::XML_SUCCESS)
-            continue;
-
-        const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
-        if (rootNode == nullptr)
-            continue;
-
-        for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
-            if (std::strcmp(e->Name(), "FileInfo") != 0)
-                continue;
-            const char *checkattr = e->Attribute("check");
-            if (checkattr == nullptr || std::strcmp(checkattr,"CheckUnusedFunctions") != 0)
-                continue;
+        AnalyzerInformation::readFileInfo(analyzerInfoFile, {"CheckUnusedFunctions"}, [&](const std::string& /*check*/, const tinyxml2::XMLElement *e) {
             for (const tinyxml2::XMLElement *e2 = e->FirstChildElement(); e2; e2 = e2->NextSiblingElement()) {
                 const char* functionName = e2->Attribute("functionName");
                 if (functionName == nullptr)
@@ -495,7 +482,7 @@ void CheckUnusedFunctions::analyseWholeProgram(const Settings &settings, ErrorLo
                     }
                 }
             }
-        }
+        });
     }
 
     for (auto decl = decls.cbegin(); decl != decls.cend(); ++decl) {
@@ -19,12 +19,14 @@
 #include "cppcheck.h"
 
 #include "addoninfo.h"
+#include "addonworker.h"
 #include "analyzerinfo.h"
 #include "check.h"
 #include "checkunusedfunctions.h"
 #include "clangimport.h"
 #include "color.h"
 #include "ctu.h"
+#include "dumpfile.h"
 #include "errorlogger.h"
 #include "errortypes.h"
 #include "filesettings.h"
@@ -32,6 +34,7 @@
 #include "path.h"
 #include "platform.h"
 #include "preprocessor.h"
+#include "ruleengine.h"
 #include "settings.h"
 #include "standards.h"
 #include "suppressions.h"
@@ -44,17 +47,24 @@
 #include "version.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <cstdint>
 #include <cstring>
 #include <cctype>
 #include <cstdlib>
-#include <ctime>
+#include <deque>
 #include <exception> // IWYU pragma: keep
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <new>
 #include <set>
 #include <sstream>
@@ -70,13 +80,6 @@
 
 #include "xml.h"
 
-#ifdef HAVE_RULES
-#ifdef _WIN32
-#define PCRE_STATIC
-#endif
-#include <pcre.h>
-#endif
-
 class SymbolDatabase;
 
 static constexpr char Version[] = CPPCHECK_VERSION_STRING;
@@ -85,10 +88,14 @@ static constexpr char ExtraVersion[] = "";
 static constexpr char FILELIST[] = "cppcheck-addon-ctu-file-list";
 
 static TimerResults s_timerResults;
+static TimerSlowest s_slowChecks;
 
 // CWE ids used
 static const CWE CWE398(398U);  // Indicator of Poor Code Quality
 
+/** What macros are used on a location? */
+using LocationMacros = std::map<std::pair<std::string, int>, std::set<std::string>>;
+
 class CppCheck::CppCheckLogger : public ErrorLogger
 {
 public:
@@ -109,13 +116,21 @@ public:
         mRemarkComments = std::move(remarkComments);
     }
 
-    void setLocationMacros(const Token* startTok, const std::vector<std::string>& files)
+    using Location = std::pair<std::string, int>;
+
+    static LocationMacros getLocationMacros(const Token* startTok, const std::vector<std::string>& files)
     {
-        mLocationMacros.clear();
+        LocationMacros locationMacros;
         for (const Token* tok = startTok; tok; tok = tok->next()) {
             if (!tok->getMacroName().empty())
-                mLocationMacros[Location(files[tok->fileIndex()], tok->linenr())].emplace(tok->getMacroName());
+                locationMacros[Location(files[tok->fileIndex()], tok->linenr())].emplace(tok->getMacroName());
         }
+        return locationMacros;
+    }
+
+    void setLocationMacros(LocationMacros locationMacros)
+    {
+        mLocationMacros = std::move(locationMacros);
     }
 
     void resetExitCode()
@@ -272,8 +287,7 @@ private:
 
     std::vector<RemarkComment> mRemarkComments;
 
-    using Location = std::pair<std::string, int>;
-    std::map<Location, std::set<std::string>> mLocationMacros; // What macros are used on a location?
+    LocationMacros mLocationMacros; // What macros are used on a location?
 
     std::ofstream mPlistFile;
 
@@ -298,6 +312,15 @@ namespace {
     private:
         std::vector<std::string> mFilenames;
     };
+
+    /** A configuration whose tokens are being simplified */
+    struct PendingConfiguration {
+        std::string cfg;
+        std::unique_ptr<BufferedErrorLogger> logger;
+        std::unique_ptr<Tokenizer> tokenizer;
+        LocationMacros locationMacros;
+        std::future<bool> simplified;
+    };
 }
 
 static std::string cmdFileName(std::string f)
@@ -352,14 +375,19 @@ static std::string getCtuInfoFileName(const std::string &dumpFile)
 static void createDumpFile(const Settings& settings,
                            const FileWithDetails& file,
                            int fileIndex,
-                           std::ofstream& fdump,
+                           DumpFile& fdump,
                            std::string& dumpFile)
 {
     if (!settings.dump && settings.addons.empty())
         return;
     dumpFile = getDumpFileName(settings, file.spath(), fileIndex);
 
-    fdump.open(dumpFile);
+    // executable addons read the XML themselves
+    const bool binary = settings.dumpFormat == Settings::DumpFormat::binary &&
+                        std::none_of(settings.addonInfos.cbegin(), settings.addonInfos.cend(), [](const AddonInfo& addonInfo) {
+        return !addonInfo.executable.empty();
+    });
+    fdump.open(dumpFile, binary);
     if (!fdump.is_open())
         return;
 
@@ -425,6 +453,7 @@ static std::vector<picojson::value> executeAddon(const AddonInfo &addonInfo,
                                                  const std::string &defaultPythonExe,
                                                  const std::string &file,
                                                  const std::string &premiumArgs,
+                                                 bool server,
                                                  const CppCheck::ExecuteCmdFn &executeCommand)
 {
     std::string pythonExe;
@@ -455,7 +484,34 @@ static std::vector<picojson::value> executeAddon(const AddonInfo &addonInfo,
     args += fileArg;
 
     std::string result;
-    if (const int exitcode = executeCommand(pythonExe, split(args), "2>&1", result)) {
+    int exitcode = 0;
+    bool executed = false;
+    if (server && addonInfo.executable.empty()) {
+        // one worker per addon and thread, it is terminated when the thread ends
+        thread_local std::map<std::string, std::unique_ptr<AddonWorker>> workers;
+        std::unique_ptr<AddonWorker> &worker = workers[pythonExe + " " + addonInfo.scriptFile + addonInfo.args];
+        if (!worker) {
+            std::vector<std::string> workerArgs = split(pythonExe);
+            const std::string workerExe = workerArgs.front();
+            workerArgs.erase(workerArgs.begin());
+            workerArgs.emplace_back(Path::toNativeSeparators(addonInfo.runScript));
+            workerArgs.emplace_back("--server");
+            workerArgs.emplace_back(Path::toNativeSeparators(addonInfo.scriptFile));
+            workerArgs.emplace_back("--cli");
+            for (std::string &arg : split(addonInfo.args))
+                workerArgs.emplace_back(std::move(arg));
+            worker.reset(new AddonWorker(workerExe, std::move(workerArgs)));
+        }
+        picojson::array request;
+        if (is_file_list)
+            request.emplace_back(std::string("--file-list"));
+        request.emplace_back(Path::toNativeSeparators(file));
+        // fall back to a separate process if the worker cannot be started
+        executed = worker->execute(picojson::value(request).serialize(), result, exitcode);
+    }
+    if (!executed)
+        exitcode = executeCommand(pythonExe, split(args), "2>&1", result);
+    if (exitcode) {
         std::string message("Failed to execute addon '" + addonInfo.name + "' - exitcode is " + std::to_string(exitcode));
         std::string details = pythonExe + " " + args;
         if (result.size() > 2) {
@@ -730,7 +786,7 @@ unsigned int CppCheck::checkClang(const FileWithDetails &file, int fileIndex)
         checkNormalTokens(tokenizer, nullptr); // TODO: provide analyzer information
 
         // create dumpfile
-        std::ofstream fdump;
+        DumpFile fdump;
         std::string dumpFile;
         createDumpFile(mSettings, file, fileIndex, fdump, dumpFile);
         if (fdump.is_open()) {
@@ -761,6 +817,8 @@ unsigned int CppCheck::checkClang(const FileWithDetails &file, int fileIndex)
         internalError(file.spath(), std::string("Processing Clang AST dump failed: ") + e.what());
     }
 
+    addSlowChecks(file.spath());
+
     return mLogger->exitcode();
 }
 
@@ -837,12 +895,12 @@ unsigned int CppCheck::check(const FileSettings &fs)
     return returnValue;
 }
 
-static simplecpp::TokenList createTokenList(const std::string& filename, std::vector<std::string>& files, simplecpp::OutputList* outputList, std::istream* fileStream)
+static simplecpp::TokenList createTokenList(const std::string& filename, std::vector<std::string>& files, simplecpp::OutputList* outputList, std::istream* fileStream, const std::string& buildDir)
 {
     if (fileStream)
         return {*fileStream, files, filename, outputList};
 
-    return {filename, files, outputList};
+    return Preprocessor::createRawTokens(filename, files, outputList, buildDir);
 }
 
 static std::size_t calculateHash(const Preprocessor& preprocessor, const simplecpp::TokenList& tokens, const Settings& settings, const Suppressions& supprs)
@@ -904,7 +962,7 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
             // TODO: if an exception occurs in this block it will continue in an unexpected code path
             if (!mSettings.buildDir.empty())
             {
-                analyzerInformation.reset(new AnalyzerInformation);
+                analyzerInformation.reset(new AnalyzerInformation(mSettings.analyzerInfoFormat == Settings::AnalyzerInfoFormat::xml));
                 mLogger->setAnalyzerInfo(analyzerInformation.get());
             }
 
@@ -948,7 +1006,7 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
 
         simplecpp::OutputList outputList;
         std::vector<std::string> files;
-        simplecpp::TokenList tokens1 = createTokenList(file.spath(), files, &outputList, fileStream);
+        simplecpp::TokenList tokens1 = createTokenList(file.spath(), files, &outputList, fileStream, mSettings.buildDir);
 
         // If there is a syntax error, report it and stop
         const auto output_it = std::find_if(outputList.cbegin(), outputList.cend(), [](const simplecpp::Output &output){
@@ -974,7 +1032,12 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
 
         Preprocessor preprocessor(mSettings, mErrorLogger, file.lang());
 
-        if (!preprocessor.loadFiles(tokens1, files))
+        const bool loaded = preprocessor.loadFiles(tokens1, files);
+        if (mSettings.showtime != SHOWTIME_MODES::SHOWTIME_NONE) {
+            s_timerResults.addCount("Preprocessor::loadFiles::headerCacheHits", preprocessor.getHeaderCacheHits());
+            s_timerResults.addCount("Preprocessor::loadFiles::headerCacheMisses", preprocessor.getHeaderCacheMisses());
+        }
+        if (!loaded)
             return mLogger->exitcode();
 
         if (!mSettings.plistOutput.empty()) {
@@ -1004,7 +1067,7 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
         preprocessor.removeComments(tokens1);
 
         if (!mSettings.buildDir.empty()) {
-            analyzerInformation.reset(new AnalyzerInformation);
+            analyzerInformation.reset(new AnalyzerInformation(mSettings.analyzerInfoFormat == Settings::AnalyzerInfoFormat::xml));
             mLogger->setAnalyzerInfo(analyzerInformation.get());
         }
 
@@ -1073,7 +1136,7 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
         FilesDeleter filesDeleter;
 
         // write dump file xml prolog
-        std::ofstream fdump;
+        DumpFile fdump;
         std::string dumpFile;
         createDumpFile(mSettings, file, fileIndex, fdump, dumpFile);
         if (fdump.is_open()) {
@@ -1087,90 +1150,202 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
         int checkCount = 0;
         bool hasValidConfig = false;
         std::list<std::string> configurationError;
-        for (const std::string &currCfg : configurations) {
-            // bail out if terminated
-            if (Settings::terminated())
-                break;
-
-            // Check only a few configurations (default 12), after that bail out, unless --force
-            // was used.
-            if (!mSettings.force && ++checkCount > mSettings.maxConfigs)
-                break;
 
-            std::string currentConfig;
+        // The tokens of up to --config-jobs configurations are simplified in parallel. The
+        // preprocessing and the checks are still done in configuration order so the results
+        // are the same as with a sequential analysis.
+#ifdef HAS_THREADING_MODEL_THREAD
+        const std::size_t configJobs = std::max(1U, mSettings.configJobs);
+#else
+        const std::size_t configJobs = 1;
+#endif
+        std::deque<PendingConfiguration> pendingConfigs;
+        auto nextCfg = configurations.cbegin();
+        bool stop = false;
+        while (!stop || !pendingConfigs.empty()) {
+            while (!stop && pendingConfigs.size() < configJobs) {
+                if (nextCfg == configurations.cend()) {
+                    stop = true;
+                    break;
+                }
+                const std::string &currCfg = *nextCfg;
+                ++nextCfg;
 
-            if (!mSettings.userDefines.empty()) {
-                currentConfig = mSettings.userDefines;
-                const std::vector<std::string> v1(split(mSettings.userDefines, ";"));
-                for (const std::string &cfg: split(currCfg, ";")) {
-                    if (std::find(v1.cbegin(), v1.cend(), cfg) == v1.cend()) {
-                        currentConfig += ";" + cfg;
-                    }
+                // bail out if terminated
+                if (Settings::terminated()) {
+                    stop = true;
+                    break;
                 }
-            } else {
-                currentConfig = currCfg;
-            }
 
-            if (mSettings.preprocessOnly) {
-                std::string codeWithoutCfg;
-                Timer::run("Preprocessor::getcode", mSettings.showtime, &s_timerResults, [&]() {
-                    codeWithoutCfg = preprocessor.getcode(tokens1, currentConfig, files, true);
-                });
+                // Check only a few configurations (default 12), after that bail out, unless --force
+                // was used.
+                if (!mSettings.force && ++checkCount > mSettings.maxConfigs) {
+                    stop = true;
+                    break;
+                }
 
-                if (startsWith(codeWithoutCfg,"#file"))
-                    codeWithoutCfg.insert(0U, "//");
-                std::string::size_type pos = 0;
-                while ((pos = codeWithoutCfg.find("\n#file",pos)) != std::string::npos)
-                    codeWithoutCfg.insert(pos+1U, "//");
-                pos = 0;
-                while ((pos = codeWithoutCfg.find("\n#endfile",pos)) != std::string::npos)
-                    codeWithoutCfg.insert(pos+1U, "//");
-                pos = 0;
-                while ((pos = codeWithoutCfg.find(Preprocessor::macroChar,pos)) != std::string::npos)
-                    codeWithoutCfg[pos] = ' ';
-                mErrorLogger.reportOut(codeWithoutCfg, Color::Reset);
-                continue;
-            }
+                std::string currentConfig;
 
-            try {
-                TokenList tokenlist{mSettings, file.lang()};
+                if (!mSettings.userDefines.empty()) {
+                    currentConfig = mSettings.userDefines;
+                    const std::vector<std::string> v1(split(mSettings.userDefines, ";"));
+                    for (const std::string &cfg: split(currCfg, ";")) {
+                        if (std::find(v1.cbegin(), v1.cend(), cfg) == v1.cend()) {
+                            currentConfig += ";" + cfg;
+                        }
+                    }
+                } else {
+                    currentConfig = currCfg;
+                }
 
-                // Create tokens, skip rest of iteration if failed
-                Timer::run("Tokenizer::createTokens", mSettings.showtime, &s_timerResults, [&]() {
-                    simplecpp::TokenList tokensP = preprocessor.preprocess(tokens1, currentConfig, files, true);
-                    tokenlist.createTokens(std::move(tokensP));
-                });
-                hasValidConfig = true;
+                if (mSettings.preprocessOnly) {
+                    std::string codeWithoutCfg;
+                    Timer::run("Preprocessor::getcode", mSettings.showtime, &s_timerResults, [&]() {
+                        codeWithoutCfg = preprocessor.getcode(tokens1, currentConfig, files, true);
+                    });
+
+                    if (startsWith(codeWithoutCfg,"#file"))
+                        codeWithoutCfg.insert(0U, "//");
+                    std::string::size_type pos = 0;
+                    while ((pos = codeWithoutCfg.find("\n#file",pos)) != std::string::npos)
+                        codeWithoutCfg.insert(pos+1U, "//");
+                    pos = 0;
+                    while ((pos = codeWithoutCfg.find("\n#endfile",pos)) != std::string::npos)
+                        codeWithoutCfg.insert(pos+1U, "//");
+                    pos = 0;
+                    while ((pos = codeWithoutCfg.find(Preprocessor::macroChar,pos)) != std::string::npos)
+                        codeWithoutCfg[pos] = ' ';
+                    mErrorLogger.reportOut(codeWithoutCfg, Color::Reset);
+                    continue;
+                }
 
-                Tokenizer tokenizer(std::move(tokenlist), mErrorLogger);
                 try {
-                    if (mSettings.showtime != SHOWTIME_MODES::SHOWTIME_NONE)
-                        tokenizer.setTimerResults(&s_timerResults);
-                    tokenizer.setDirectives(directives); // TODO: how to avoid repeated copies?
+                    PendingConfiguration pending;
+                    pending.cfg = currentConfig;
+                    if (configJobs > 1)
+                        pending.logger.reset(new BufferedErrorLogger);
+                    // tokens keep a reference to their list so create them in the list owned by the tokenizer
+                    pending.tokenizer.reset(new Tokenizer(TokenList{mSettings, file.lang()}, pending.logger ? *pending.logger : mErrorLogger));
+                    Tokenizer &tokenizer = *pending.tokenizer;
+
+                    // Create tokens, skip rest of iteration if failed
+                    Timer::run("Tokenizer::createTokens", mSettings.showtime, &s_timerResults, [&]() {
+                        simplecpp::TokenList tokensP = preprocessor.preprocess(tokens1, currentConfig, files, true);
+                        tokenizer.list.createTokens(std::move(tokensP));
+                    });
+                    hasValidConfig = true;
+                    bool simplify = false;
+                    try {
+                        if (mSettings.showtime != SHOWTIME_MODES::SHOWTIME_NONE || TimerTrace::enabled())
+                            tokenizer.setTimerResults(&s_timerResults);
+                        tokenizer.setDirectives(directives); // TODO: how to avoid repeated copies?
+
+                        // locations macros
+                        LocationMacros locationMacros = CppCheckLogger::getLocationMacros(tokenizer.tokens(), files);
+                        if (pending.logger)
+                            pending.locationMacros = locationMacros;
+                        mLogger->setLocationMacros(std::move(locationMacros));
+
+                        // If only errors are printed, print filename after the check
+                        if (!mSettings.quiet && (!currentConfig.empty() || checkCount > 1)) {
+                            std::string fixedpath = Path::toNativeSeparators(file.spath());
+                            (pending.logger ? *pending.logger : mErrorLogger).reportOut("Checking " + fixedpath + ": " + currentConfig + "...", Color::FgGreen);
+                        }
 
-                    // locations macros
-                    mLogger->setLocationMacros(tokenizer.tokens(), files);
+                        // skip rest of iteration if there are no tokens or if just checking configuration
+                        if (tokenizer.tokens() && !mSettings.checkConfiguration) {
+#ifdef HAVE_RULES
+                            // Execute rules for "raw" code
+                            executeRules("raw", tokenizer.list);
+#endif
+                            simplify = true;
+                        }
+                    } catch (const InternalError &e) {
+                        ErrorMessage errmsg = ErrorMessage::fromInternalError(e, &tokenizer.list, file.spath());
+                        (pending.logger ? *pending.logger : mErrorLogger).reportErr(errmsg);
+                    }
 
-                    // If only errors are printed, print filename after the check
-                    if (!mSettings.quiet && (!currentConfig.empty() || checkCount > 1)) {
-                        std::string fixedpath = Path::toNativeSeparators(file.spath());
-                        mErrorLogger.reportOut("Checking " + fixedpath + ": " + currentConfig + "...", Color::FgGreen);
+                    // Simplify tokens into normal form - deferred to the check of the configuration
+                    // when it is not done in parallel
+                    if (simplify) {
+                        Tokenizer *tokenizerPtr = pending.tokenizer.get();
+                        pending.simplified = std::async(configJobs > 1 ? std::launch::async : std::launch::deferred, [tokenizerPtr, currentConfig, fileIndex]() {
+                            const Timer timer("Tokenizer::simplifyTokens1", SHOWTIME_MODES::SHOWTIME_NONE);
+                            return tokenizerPtr->simplifyTokens1(currentConfig, fileIndex);
+                        });
                     }
 
-                    if (!tokenizer.tokens())
-                        continue;
+                    // skipped configurations are queued as well so their messages are forwarded in order
+                    if (simplify || pending.logger)
+                        pendingConfigs.push_back(std::move(pending));
+                } catch (const simplecpp::Output &o) {
+                    // #error etc during preprocessing
+                    configurationError.push_back((currentConfig.empty() ? "\'\'" : currentConfig) + " : [" + o.location.file() + ':' + std::to_string(o.location.line) + "] " + o.msg);
+                    --checkCount; // don't count invalid configurations
+
+                    if (!hasValidConfig && currCfg == *configurations.rbegin()) {
+                        // If there is no valid configuration then report error..
+                        std::string locfile = Path::fromNativeSeparators(o.location.file());
+                        if (mSettings.relativePaths)
+                            locfile = Path::getRelativePath(locfile, mSettings.basePaths);
+
+                        ErrorMessage::FileLocation loc1(locfile, o.location.line, o.location.col);
+
+                        ErrorMessage errmsg({std::move(loc1)},
+                                            file.spath(),
+                                            Severity::error,
+                                            o.msg,
+                                            "preprocessorErrorDirective",
+                                            Certainty::normal);
+                        mErrorLogger.reportErr(errmsg);
+                    }
+                    continue;
 
-                    // skip rest of iteration if just checking configuration
-                    if (mSettings.checkConfiguration)
-                        continue;
+                } catch (const TerminateException &) {
+                    // Analysis is terminated
+                    if (analyzerInformation)
+                        mLogger->setAnalyzerInfo(nullptr);
+                    return mLogger->exitcode();
+                } catch (const InternalError &e) {
+                    ErrorMessage errmsg = ErrorMessage::fromInternalError(e, nullptr, file.spath());
+                    mErrorLogger.reportErr(errmsg);
+                }
+            }
 
-#ifdef HAVE_RULES
-                    // Execute rules for "raw" code
-                    executeRules("raw", tokenizer.list);
-#endif
+            if (pendingConfigs.empty())
+                continue;
+
+            // check the oldest configuration
+            PendingConfiguration pending = std::move(pendingConfigs.front());
+            pendingConfigs.pop_front();
+            const std::string &currentConfig = pending.cfg;
+            Tokenizer &tokenizer = *pending.tokenizer;
+            // only traced, the times of the configurations are not shown
+            const Timer configTimer("Configuration '" + currentConfig + "'", SHOWTIME_MODES::SHOWTIME_NONE);
+
+            if (pending.logger)
+                mLogger->setLocationMacros(std::move(pending.locationMacros));
+
+            if (!pending.simplified.valid()) {
+                pending.logger->forward(mErrorLogger);
+                continue;
+            }
 
-                    // Simplify tokens into normal form, skip rest of iteration if failed
-                    if (!tokenizer.simplifyTokens1(currentConfig, fileIndex))
+            try {
+                try {
+                    bool simplified;
+                    try {
+                        simplified = pending.simplified.get();
+                    } catch (...) {
+                        if (pending.logger)
+                            pending.logger->forward(mErrorLogger);
+                        throw;
+                    }
+                    if (pending.logger)
+                        pending.logger->forward(mErrorLogger);
+
+                    // skip rest of iteration if simplification failed
+                    if (!simplified || Settings::terminated())
                         continue;
 
                     // dump xml if --dump
@@ -1204,33 +1379,12 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
 
                     // Check normal tokens
                     checkNormalTokens(tokenizer, analyzerInformation.get());
+                    if (pending.logger)
+                        pending.logger->forward(mErrorLogger);
                 } catch (const InternalError &e) {
                     ErrorMessage errmsg = ErrorMessage::fromInternalError(e, &tokenizer.list, file.spath());
                     mErrorLogger.reportErr(errmsg);
                 }
-            } catch (const simplecpp::Output &o) {
-                // #error etc during preprocessing
-                configurationError.push_back((currentConfig.empty() ? "\'\'" : currentConfig) + " : [" + o.location.file() + ':' + std::to_string(o.location.line) + "] " + o.msg);
-                --checkCount; // don't count invalid configurations
-
-                if (!hasValidConfig && currCfg == *configurations.rbegin()) {
-                    // If there is no valid configuration then report error..
-                    std::string locfile = Path::fromNativeSeparators(o.location.file());
-                    if (mSettings.relativePaths)
-                        locfile = Path::getRelativePath(locfile, mSettings.basePaths);
-
-                    ErrorMessage::FileLocation loc1(locfile, o.location.line, o.location.col);
-
-                    ErrorMessage errmsg({std::move(loc1)},
-                                        file.spath(),
-                                        Severity::error,
-                                        o.msg,
-                                        "preprocessorErrorDirective",
-                                        Certainty::normal);
-                    mErrorLogger.reportErr(errmsg);
-                }
-                continue;
-
             } catch (const TerminateException &) {
                 // Analysis is terminated
                 if (analyzerInformation)
@@ -1300,6 +1454,8 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
     // TODO: clear earlier?
     mLogger->clear();
 
+    addSlowChecks(file.spath());
+
     if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_FILE || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_FILE)
         printTimerResults(mSettings.showtime);
 
@@ -1337,7 +1493,9 @@ void CppCheck::checkNormalTokens(const Tokenizer &tokenizer, AnalyzerInformation
     const bool doUnusedFunctionOnly = unusedFunctionOnly && (std::strcmp(unusedFunctionOnly, "1") == 0);
 
     if (!doUnusedFunctionOnly) {
-        const std::time_t maxTime = mSettings.checksMaxTime > 0 ? std::time(nullptr) + mSettings.checksMaxTime : 0;
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point maxTime = mSettings.checksMaxTime > 0 ? Clock::now() + std::chrono::seconds(mSettings.checksMaxTime) : Clock::time_point::max();
+        const bool timeChecks = !mSettings.checkMaxTime.empty() || mSettings.reportSlowChecks > 0;
 
         // call all "runChecks" in all registered Check classes
         // cppcheck-suppress shadowFunction - TODO: fix this
@@ -1345,7 +1503,7 @@ void CppCheck::checkNormalTokens(const Tokenizer &tokenizer, AnalyzerInformation
             if (Settings::terminated())
                 return;
 
-            if (maxTime > 0 && std::time(nullptr) > maxTime) {
+            if (Clock::now() > maxTime) {
                 if (mSettings.debugwarnings) {
                     ErrorMessage::FileLocation loc(tokenizer.list.getFiles()[0], 0, 0);
                     ErrorMessage errmsg({std::move(loc)},
@@ -1359,9 +1517,35 @@ void CppCheck::checkNormalTokens(const Tokenizer &tokenizer, AnalyzerInformation
                 return;
             }
 
+            if (!timeChecks) {
+                Timer::run(check->name() + "::runChecks", mSettings.showtime, &s_timerResults, [&]() {
+                    check->runChecks(tokenizer, &mErrorLogger);
+                });
+                continue;
+            }
+
+            // the time of the check is summed up for all configurations of the file
+            std::chrono::nanoseconds &checkTime = mCheckTimes[check->name()];
+            const auto checkMaxTime = mSettings.checkMaxTime.find(check->name());
+            if (checkMaxTime != mSettings.checkMaxTime.cend() && checkTime > std::chrono::seconds(checkMaxTime->second)) {
+                if (mSettings.debugwarnings) {
+                    ErrorMessage::FileLocation loc(tokenizer.list.getFiles()[0], 0, 0);
+                    ErrorMessage errmsg({std::move(loc)},
+                                        "",
+                                        Severity::debug,
+                                        "Check '" + check->name() + "' maximum time exceeded",
+                                        "checkMaxTime",
+                                        Certainty::normal);
+                    mErrorLogger.reportErr(errmsg);
+                }
+                continue;
+            }
+
+            const Clock::time_point start = Clock::now();
             Timer::run(check->name() + "::runChecks", mSettings.showtime, &s_timerResults, [&]() {
                 check->runChecks(tokenizer, &mErrorLogger);
             });
+            checkTime += Clock::now() - start;
         }
     }
 
@@ -1423,167 +1607,43 @@ bool CppCheck::hasRule(const std::string &tokenlist) const
     });
 }
 
-static const char * pcreErrorCodeToString(const int pcreExecRet)
-{
-    switch (pcreExecRet) {
-    case PCRE_ERROR_NULL:
-        return "Either code or subject was passed as NULL, or ovector was NULL "
-               "and ovecsize was not zero (PCRE_ERROR_NULL)";
-    case PCRE_ERROR_BADOPTION:
-        return "An unrecognized bit was set in the options argument (PCRE_ERROR_BADOPTION)";
-    case PCRE_ERROR_BADMAGIC:
-        return "PCRE stores a 4-byte \"magic number\" at the start of the compiled code, "
-               "to catch the case when it is passed a junk pointer and to detect when a "
-               "pattern that was compiled in an environment of one endianness is run in "
-               "an environment with the other endianness. This is the error that PCRE "
-               "gives when the magic number is not present (PCRE_ERROR_BADMAGIC)";
-    case PCRE_ERROR_UNKNOWN_NODE:
-        return "While running the pattern match, an unknown item was encountered in the "
-               "compiled pattern. This error could be caused by a bug in PCRE or by "
-               "overwriting of the compiled pattern (PCRE_ERROR_UNKNOWN_NODE)";
-    case PCRE_ERROR_NOMEMORY:
-        return "If a pattern contains back references, but the ovector that is passed "
-               "to pcre_exec() is not big enough to remember the referenced substrings, "
-               "PCRE gets a block of memory at the start of matching to use for this purpose. "
-               "If the call via pcre_malloc() fails, this error is given. The memory is "
-               "automatically freed at the end of matching. This error is also given if "
-               "pcre_stack_malloc() fails in pcre_exec(). "
-               "This can happen only when PCRE has been compiled with "
-               "--disable-stack-for-recursion (PCRE_ERROR_NOMEMORY)";
-    case PCRE_ERROR_NOSUBSTRING:
-        return "This error is used by the pcre_copy_substring(), pcre_get_substring(), "
-               "and pcre_get_substring_list() functions (see below). "
-               "It is never returned by pcre_exec() (PCRE_ERROR_NOSUBSTRING)";
-    case PCRE_ERROR_MATCHLIMIT:
-        return "The backtracking limit, as specified by the match_limit field in a pcre_extra "
-               "structure (or defaulted) was reached. "
-               "See the description above (PCRE_ERROR_MATCHLIMIT)";
-    case PCRE_ERROR_CALLOUT:
-        return "This error is never generated by pcre_exec() itself. "
-               "It is provided for use by callout functions that want to yield a distinctive "
-               "error code. See the pcrecallout documentation for details (PCRE_ERROR_CALLOUT)";
-    case PCRE_ERROR_BADUTF8:
-        return "A string that contains an invalid UTF-8 byte sequence was passed as a subject, "
-               "and the PCRE_NO_UTF8_CHECK option was not set. If the size of the output vector "
-               "(ovecsize) is at least 2, the byte offset to the start of the the invalid UTF-8 "
-               "character is placed in the first element, and a reason code is placed in the "
-               "second element. The reason codes are listed in the following section. For "
-               "backward compatibility, if PCRE_PARTIAL_HARD is set and the problem is a truncated "
-               "UTF-8 character at the end of the subject (reason codes 1 to 5), "
-               "PCRE_ERROR_SHORTUTF8 is returned instead of PCRE_ERROR_BADUTF8";
-    case PCRE_ERROR_BADUTF8_OFFSET:
-        return "The UTF-8 byte sequence that was passed as a subject was checked and found to "
-               "be valid (the PCRE_NO_UTF8_CHECK option was not set), but the value of "
-               "startoffset did not point to the beginning of a UTF-8 character or the end of "
-               "the subject (PCRE_ERROR_BADUTF8_OFFSET)";
-    case PCRE_ERROR_PARTIAL:
-        return "The subject string did not match, but it did match partially. See the "
-               "pcrepartial documentation for details of partial matching (PCRE_ERROR_PARTIAL)";
-    case PCRE_ERROR_BADPARTIAL:
-        return "This code is no longer in use. It was formerly returned when the PCRE_PARTIAL "
-               "option was used with a compiled pattern containing items that were not supported "
-               "for partial matching. From release 8.00 onwards, there are no restrictions on "
-               "partial matching (PCRE_ERROR_BADPARTIAL)";
-    case PCRE_ERROR_INTERNAL:
-        return "An unexpected internal error has occurred. This error could be caused by a bug "
-               "in PCRE or by overwriting of the compiled pattern (PCRE_ERROR_INTERNAL)";
-    case PCRE_ERROR_BADCOUNT:
-        return "This error is given if the value of the ovecsize argument is negative "
-               "(PCRE_ERROR_BADCOUNT)";
-    case PCRE_ERROR_RECURSIONLIMIT:
-        return "The internal recursion limit, as specified by the match_limit_recursion "
-               "field in a pcre_extra structure (or defaulted) was reached. "
-               "See the description above (PCRE_ERROR_RECURSIONLIMIT)";
-    case PCRE_ERROR_DFA_UITEM:
-        return "PCRE_ERROR_DFA_UITEM";
-    case PCRE_ERROR_DFA_UCOND:
-        return "PCRE_ERROR_DFA_UCOND";
-    case PCRE_ERROR_DFA_WSSIZE:
-        return "PCRE_ERROR_DFA_WSSIZE";
-    case PCRE_ERROR_DFA_RECURSE:
-        return "PCRE_ERROR_DFA_RECURSE";
-    case PCRE_ERROR_NULLWSLIMIT:
-        return "PCRE_ERROR_NULLWSLIMIT";
-    case PCRE_ERROR_BADNEWLINE:
-        return "An invalid combination of PCRE_NEWLINE_xxx options was "
-               "given (PCRE_ERROR_BADNEWLINE)";
-    case PCRE_ERROR_BADOFFSET:
-        return "The value of startoffset was negative or greater than the length "
-               "of the subject, that is, the value in length (PCRE_ERROR_BADOFFSET)";
-    case PCRE_ERROR_SHORTUTF8:
-        return "This error is returned instead of PCRE_ERROR_BADUTF8 when the subject "
-               "string ends with a truncated UTF-8 character and the PCRE_PARTIAL_HARD option is set. "
-               "Information about the failure is returned as for PCRE_ERROR_BADUTF8. "
-               "It is in fact sufficient to detect this case, but this special error code for "
-               "PCRE_PARTIAL_HARD precedes the implementation of returned information; "
-               "it is retained for backwards compatibility (PCRE_ERROR_SHORTUTF8)";
-    case PCRE_ERROR_RECURSELOOP:
-        return "This error is returned when pcre_exec() detects a recursion loop "
-               "within the pattern. Specifically, it means that either the whole pattern "
-               "or a subpattern has been called recursively for the second time at the same "
-               "position in the subject string. Some simple patterns that might do this "
-               "are detected and faulted at compile time, but more complicated cases, "
-               "in particular mutual recursions between two different subpatterns, "
-               "cannot be detected until run time (PCRE_ERROR_RECURSELOOP)";
-    case PCRE_ERROR_JIT_STACKLIMIT:
-        return "This error is returned when a pattern that was successfully studied "
-               "using a JIT compile option is being matched, but the memory available "
-               "for the just-in-time processing stack is not large enough. See the pcrejit "
-               "documentation for more details (PCRE_ERROR_JIT_STACKLIMIT)";
-    case PCRE_ERROR_BADMODE:
-        return "This error is given if a pattern that was compiled by the 8-bit library "
-               "is passed to a 16-bit or 32-bit library function, or vice versa (PCRE_ERROR_BADMODE)";
-    case PCRE_ERROR_BADENDIANNESS:
-        return "This error is given if a pattern that was compiled and saved is reloaded on a "
-               "host with different endianness. The utility function pcre_pattern_to_host_byte_order() "
-               "can be used to convert such a pattern so that it runs on the new host (PCRE_ERROR_BADENDIANNESS)";
-    case PCRE_ERROR_DFA_BADRESTART:
-        return "PCRE_ERROR_DFA_BADRESTART";
-#if PCRE_MAJOR >= 8 && PCRE_MINOR >= 32
-    case PCRE_ERROR_BADLENGTH:
-        return "This error is given if pcre_exec() is called with a negative value for the length argument (PCRE_ERROR_BADLENGTH)";
-    case PCRE_ERROR_JIT_BADOPTION:
-        return "This error is returned when a pattern that was successfully studied using a JIT compile "
-               "option is being matched, but the matching mode (partial or complete match) does not correspond "
-               "to any JIT compilation mode. When the JIT fast path function is used, this error may be "
-               "also given for invalid options. See the pcrejit documentation for more details (PCRE_ERROR_JIT_BADOPTION)";
-#endif
-    }
-    return "";
-}
-
 void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
 {
     // There is no rule to execute
     if (!hasRule(tokenlist))
         return;
 
-    // Write all tokens in a string that can be parsed by pcre
+    // the rules are compiled once and shared by all files
+    const std::shared_ptr<const RuleEngine> ruleEngine = RuleEngine::get(mSettings.rules);
+
+    // Write all tokens in a string that can be parsed by pcre, the offsets of the tokens are used to locate the matches
     std::string str;
+    std::vector<std::pair<std::size_t, const Token *>> tokenOffsets;
     for (const Token *tok = list.front(); tok; tok = tok->next()) {
         str += " ";
         str += tok->str();
+        tokenOffsets.emplace_back(str.size(), tok);
     }
 
-    for (const Settings::Rule &rule : mSettings.rules) {
-        if (rule.tokenlist != tokenlist)
-            continue;
+    // the rules that can not match are not executed, the literals of all rules are searched at once
+    const std::vector<const RuleEngine::CompiledRule *> rules = ruleEngine->getRules(tokenlist);
+    const std::vector<bool> candidates = ruleEngine->candidates(tokenlist, str);
+
+    for (std::size_t i = 0; i < rules.size(); ++i) {
+        const RuleEngine::CompiledRule &compiledRule = *rules[i];
+        const Settings::Rule &rule = compiledRule.rule;
 
         if (!mSettings.quiet) {
             mErrorLogger.reportOut("Processing rule: " + rule.pattern, Color::FgGreen);
         }
 
-        const char *pcreCompileErrorStr = nullptr;
-        int erroffset = 0;
-        pcre * const re = pcre_compile(rule.pattern.c_str(),0,&pcreCompileErrorStr,&erroffset,nullptr);
-        if (!re) {
-            if (pcreCompileErrorStr) {
-                const std::string msg = "pcre_compile failed: " + std::string(pcreCompileErrorStr);
+        if (!compiledRule.errorId.empty()) {
+            if (!compiledRule.errorMsg.empty()) {
                 const ErrorMessage errmsg(std::list<ErrorMessage::FileLocation>(),
                                           "",
                                           Severity::error,
-                                          msg,
-                                          "pcre_compile",
+                                          compiledRule.errorMsg,
+                                          compiledRule.errorId,
                                           Certainty::normal);
 
                 mErrorLogger.reportErr(errmsg);
@@ -1591,67 +1651,27 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
             continue;
         }
 
-        // Optimize the regex, but only if PCRE_CONFIG_JIT is available
-#ifdef PCRE_CONFIG_JIT
-        const char *pcreStudyErrorStr = nullptr;
-        pcre_extra * const pcreExtra = pcre_study(re, PCRE_STUDY_JIT_COMPILE, &pcreStudyErrorStr);
-        // pcre_study() returns NULL for both errors and when it can not optimize the regex.
-        // The last argument is how one checks for errors.
-        // It is NULL if everything works, and points to an error string otherwise.
-        if (pcreStudyErrorStr) {
-            const std::string msg = "pcre_study failed: " + std::string(pcreStudyErrorStr);
-            const ErrorMessage errmsg(std::list<ErrorMessage::FileLocation>(),
-                                      "",
-                                      Severity::error,
-                                      msg,
-                                      "pcre_study",
-                                      Certainty::normal);
-
-            mErrorLogger.reportErr(errmsg);
-            // pcre_compile() worked, but pcre_study() returned an error. Free the resources allocated by pcre_compile().
-            pcre_free(re);
+        if (!candidates[i])
             continue;
-        }
-#else
-        const pcre_extra * const pcreExtra = nullptr;
-#endif
-
-        int pos = 0;
-        int ovector[30]= {0};
-        while (pos < static_cast<int>(str.size())) {
-            const int pcreExecRet = pcre_exec(re, pcreExtra, str.c_str(), static_cast<int>(str.size()), pos, 0, ovector, 30);
-            if (pcreExecRet < 0) {
-                const std::string errorMessage = pcreErrorCodeToString(pcreExecRet);
-                if (!errorMessage.empty()) {
-                    const ErrorMessage errmsg(std::list<ErrorMessage::FileLocation>(),
-                                              "",
-                                              Severity::error,
-                                              std::string("pcre_exec failed: ") + errorMessage,
-                                              "pcre_exec",
-                                              Certainty::normal);
-
-                    mErrorLogger.reportErr(errmsg);
-                }
-                break;
-            }
-            const auto pos1 = static_cast<unsigned int>(ovector[0]);
-            const auto pos2 = static_cast<unsigned int>(ovector[1]);
 
+        std::size_t pos = 0;
+        std::size_t pos1 = 0;
+        std::size_t pos2 = 0;
+        std::string errorMessage;
+        while (compiledRule.match(str, pos, pos1, pos2, errorMessage)) {
             // jump to the end of the match for the next pcre_exec
-            pos = static_cast<int>(pos2);
+            pos = pos2;
 
             // determine location..
             int fileIndex = 0;
             int line = 0;
 
-            std::size_t len = 0;
-            for (const Token *tok = list.front(); tok; tok = tok->next()) {
-                len = len + 1U + tok->str().size();
-                if (len > pos1) {
-                    fileIndex = tok->fileIndex();
-                    line = tok->linenr();
-                    break;
-                }
+            const auto it = std::upper_bound(tokenOffsets.cbegin(), tokenOffsets.cend(), pos1, [](std::size_t offset, const std::pair<std::size_t, const Token *>& tokenOffset) {
+                return offset < tokenOffset.first;
+            });
+            if (it != tokenOffsets.cend()) {
+                fileIndex = it->second->fileIndex();
+                line = it->second->linenr();
             }
 
             const std::string& file = list.getFiles()[fileIndex];
@@ -1670,13 +1690,16 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
             mErrorLogger.reportErr(errmsg);
         }
 
-        pcre_free(re);
-#ifdef PCRE_CONFIG_JIT
-        // Free up the EXTRA PCRE value (may be NULL at this point)
-        if (pcreExtra) {
-            pcre_free_study(pcreExtra);
+        if (!errorMessage.empty()) {
+            const ErrorMessage errmsg(std::list<ErrorMessage::FileLocation>(),
+                                      "",
+                                      Severity::error,
+                                      std::string("pcre_exec failed: ") + errorMessage,
+                                      "pcre_exec",
+                                      Certainty::normal);
+
+            mErrorLogger.reportErr(errmsg);
         }
-#endif
     }
 }
 #endif
@@ -1720,7 +1743,7 @@ void CppCheck::executeAddons(const std::vector<std::string>& files, const std::s
         std::vector<picojson::value> results;
 
         try {
-            results = executeAddon(addonInfo, mSettings.addonPython, fileList.empty() ? files[0] : fileList, mSettings.premiumArgs, mExecuteCommand);
+            results = executeAddon(addonInfo, mSettings.addonPython, fileList.empty() ? files[0] : fileList, mSettings.premiumArgs, mSettings.addonServer, mExecuteCommand);
         } catch (const InternalError& e) {
             const std::string ctx = isCtuInfo ? "Whole program analysis" : "Checking file";
             const ErrorMessage errmsg = ErrorMessage::fromInternalError(e, nullptr, file0, "Bailing out from analysis: " + ctx + " failed");
@@ -1997,6 +2020,45 @@ void CppCheck::analyseClangTidy(const FileSettings &fileSettings)
     }
 }
 
+/**
+ * Run the whole program analysis of all checks. With several jobs the checks are run
+ * in parallel, the messages are reported in the order of the checks.
+ */
+static bool analyseWholeProgramChecks(const CTU::FileInfo &ctu, const std::list<Check::FileInfo*> &fileInfo, const Settings &settings, ErrorLogger &errorLogger)
+{
+    // cppcheck-suppress shadowFunction - TODO: fix this
+    const std::vector<Check *> checks(Check::instances().cbegin(), Check::instances().cend());
+    bool errors = false;
+
+#ifdef HAS_THREADING_MODEL_THREAD
+    const std::size_t jobs = std::min<std::size_t>(std::max(1U, settings.jobs), checks.size());
+    if (jobs > 1) {
+        std::vector<BufferedErrorLogger> loggers(checks.size());
+        std::vector<char> results(checks.size(), 0);
+        std::atomic<std::size_t> next{0};
+        std::vector<std::future<void>> workers;
+        for (std::size_t j = 0; j < jobs; ++j) {
+            workers.emplace_back(std::async(std::launch::async, [&]() {
+                for (std::size_t i = next++; i < checks.size(); i = next++)
+                    results[i] = checks[i]->analyseWholeProgram(ctu, fileInfo, settings, loggers[i]);
+            }));
+        }
+        for (std::future<void> &worker : workers)
+            worker.get();
+
+        for (std::size_t i = 0; i < checks.size(); ++i) {
+            loggers[i].forward(errorLogger);
+            errors |= (results[i] != 0);
+        }
+        return errors;
+    }
+#endif
+
+    for (Check *check : checks)
+        errors |= check->analyseWholeProgram(ctu, fileInfo, settings, errorLogger);
+    return errors;
+}
+
 bool CppCheck::analyseWholeProgram()
 {
     bool errors = false;
@@ -2013,9 +2075,7 @@ bool CppCheck::analyseWholeProgram()
         }
     }
 
-    // cppcheck-suppress shadowFunction - TODO: fix this
-    for (Check *check : Check::instances())
-        errors |= check->analyseWholeProgram(ctu, mFileInfo, mSettings, mErrorLogger);  // TODO: ctu
+    errors |= analyseWholeProgramChecks(ctu, mFileInfo, mSettings, mErrorLogger);  // TODO: ctu
 
     if (mUnusedFunctionsCheck)
         errors |= mUnusedFunctionsCheck->check(mSettings, mErrorLogger);
@@ -2031,51 +2091,72 @@ unsigned int CppCheck::analyseWholeProgram(const std::string &buildDir, const st
     std::list<Check::FileInfo*> fileInfoList;
     CTU::FileInfo ctuFileInfo;
 
-    // Load all analyzer info data..
-    const std::string filesTxt(buildDir + "/files.txt");
-    std::ifstream fin(filesTxt);
-    std::string filesTxtLine;
-    while (std::getline(fin, filesTxtLine)) {
-        AnalyzerInformation::Info filesTxtInfo;
-        if (!filesTxtInfo.parse(filesTxtLine))
-            continue;
+    std::vector<AnalyzerInformation::Info> filesTxtInfos;
+    {
+        const std::string filesTxt(buildDir + "/files.txt");
+        std::ifstream fin(filesTxt);
+        std::string filesTxtLine;
+        while (std::getline(fin, filesTxtLine)) {
+            AnalyzerInformation::Info filesTxtInfo;
+            if (filesTxtInfo.parse(filesTxtLine))
+                filesTxtInfos.push_back(std::move(filesTxtInfo));
+        }
+    }
 
-        const std::string xmlfile = buildDir + '/' + filesTxtInfo.afile;
+    std::map<std::string, const Check *> checks;
+    // cppcheck-suppress shadowFunction - TODO: fix this
+    for (const Check *check : Check::instances())
+        checks.emplace(check->name(), check);
 
-        tinyxml2::XMLDocument doc;
-        const tinyxml2::XMLError error = doc.LoadFile(xmlfile.c_str());
-        if (error != tinyxml2::XML_SUCCESS)
-            continue;
+    // Load all analyzer info data..
+    struct LoadedFileInfo {
+        std::list<Check::FileInfo*> fileInfoList;
+        CTU::FileInfo ctuFileInfo;
+    };
+    std::vector<LoadedFileInfo> loaded(filesTxtInfos.size());
+    const auto load = [&](std::size_t i) {
+        const AnalyzerInformation::Info &filesTxtInfo = filesTxtInfos[i];
+        LoadedFileInfo &fileInfo = loaded[i];
+        AnalyzerInformation::readFileInfo(buildDir + '/' + filesTxtInfo.afile, {}, [&](const std::string &checkName, const tinyxml2::XMLElement *e) {
+            if (checkName == "ctu") {
+                fileInfo.ctuFileInfo.loadFromXml(e);
+                return;
+            }
+            const auto it = checks.find(checkName);
+            if (it == checks.end())
+                return;
+            Check::FileInfo* fi = it->second->loadFileInfoFromXml(e);
+            fi->file0 = filesTxtInfo.sourceFile;
+            fileInfo.fileInfoList.push_back(fi);
+        });
+    };
 
-        const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
-        if (rootNode == nullptr)
-            continue;
+#ifdef HAS_THREADING_MODEL_THREAD
+    // the files are loaded in parallel and merged in the order of files.txt
+    const std::size_t jobs = std::min<std::size_t>(std::max(1U, mSettings.jobs), loaded.size());
+    std::atomic<std::size_t> next{0};
+    std::vector<std::future<void>> loaders;
+    for (std::size_t j = 0; j < jobs; ++j) {
+        loaders.emplace_back(std::async(std::launch::async, [&]() {
+            for (std::size_t i = next++; i < loaded.size(); i = next++)
+                load(i);
+        }));
+    }
+    for (std::future<void> &loader : loaders)
+        loader.get();
+#else
+    for (std::size_t i = 0; i < loaded.size(); ++i)
+        load(i);
+#endif
 
-        for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
-            if (std::strcmp(e->Name(), "FileInfo") != 0)
-                continue;
-            const char *checkClassAttr = e->Attribute("check");
-            if (!checkClassAttr)
-                continue;
-            if (std::strcmp(checkClassAttr, "ctu") == 0) {
-                ctuFileInfo.loadFromXml(e);
-                continue;
-            }
-            // cppcheck-suppress shadowFunction - TODO: fix this
-            for (const Check *check : Check::instances()) {
-                if (checkClassAttr == check->name()) {
-                    Check::FileInfo* fi = check->loadFileInfoFromXml(e);
-                    fi->file0 = filesTxtInfo.sourceFile;
-                    fileInfoList.push_back(fi);
-                }
-            }
-        }
+    for (LoadedFileInfo &fileInfo : loaded) {
+        fileInfoList.splice(fileInfoList.end(), fileInfo.fileInfoList);
+        ctuFileInfo.functionCalls.splice(ctuFileInfo.functionCalls.end(), fileInfo.ctuFileInfo.functionCalls);
+        ctuFileInfo.nestedCalls.splice(ctuFileInfo.nestedCalls.end(), fileInfo.ctuFileInfo.nestedCalls);
     }
 
     // Analyse the tokens
-    // cppcheck-suppress shadowFunction - TODO: fix this
-    for (Check *check : Check::instances())
-        check->analyseWholeProgram(ctuFileInfo, fileInfoList, mSettings, mErrorLogger);
+    analyseWholeProgramChecks(ctuFileInfo, fileInfoList, mSettings, mErrorLogger);
 
     if (mUnusedFunctionsCheck)
         mUnusedFunctionsCheck->check(mSettings, mErrorLogger);
@@ -2097,6 +2178,20 @@ void CppCheck::printTimerResults(SHOWTIME_MODES mode)
     s_timerResults.showResults(mode);
 }
 
+void CppCheck::printSlowChecks()
+{
+    s_slowChecks.showResults("Slowest checks");
+}
+
+void CppCheck::addSlowChecks(const std::string& file)
+{
+    if (mSettings.reportSlowChecks > 0) {
+        for (const auto& checkTime : mCheckTimes)
+            s_slowChecks.add(file + ": " + checkTime.first, checkTime.second, mSettings.reportSlowChecks);
+    }
+    mCheckTimes.clear();
+}
+
 bool CppCheck::isPremiumCodingStandardId(const std::string& id) const {
     if (mSettings.premiumArgs.find("--misra") != std::string::npos) {
         if (startsWith(id, "misra-") || startsWith(id, "premium-misra-"))
@@ -24,10 +24,12 @@
 #include "check.h"
 #include "config.h"
 
+#include <chrono>
 #include <cstdint>
 #include <fstream>
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -139,11 +141,17 @@ public:
     static void resetTimerResults();
     static void printTimerResults(SHOWTIME_MODES mode);
 
+    /** print the slowest checks of the analyzed files (--report-slow-checks) */
+    static void printSlowChecks();
+
 private:
     void purgedConfigurationMessage(const std::string &file, const std::string& configuration);
 
     bool isPremiumCodingStandardId(const std::string& id) const;
 
+    /** add the times of the checks of the file to the slowest checks */
+    void addSlowChecks(const std::string& file);
+
     /**
      * @brief Get dumpfile <rawtokens> contents, this is only public for testing purposes
      */
@@ -222,6 +230,9 @@ private:
     ExecuteCmdFn mExecuteCommand;
 
     std::unique_ptr<CheckUnusedFunctions> mUnusedFunctionsCheck;
+
+    /** time of each check for the current file */
+    std::map<std::string, std::chrono::nanoseconds> mCheckTimes;
 };
 
 /// @}
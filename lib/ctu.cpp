@@ -33,6 +33,7 @@
 #include <cstdint>
 #include <cstring>
 #include <iterator>  // back_inserter
+#include <mutex>
 #include <sstream>
 #include <utility>
 
@@ -248,14 +249,15 @@ void CTU::FileInfo::loadFromXml(const tinyxml2::XMLElement *xmlElement)
     }
 }
 
-std::map<std::string, std::list<const CTU::FileInfo::CallBase *>> CTU::FileInfo::getCallsMap() const
+const std::map<std::string, std::list<const CTU::FileInfo::CallBase *>> &CTU::FileInfo::getCallsMap() const
 {
-    std::map<std::string, std::list<const CTU::FileInfo::CallBase *>> ret;
-    for (const CTU::FileInfo::NestedCall &nc : nestedCalls)
-        ret[nc.callId].push_back(&nc);
-    for (const CTU::FileInfo::FunctionCall &fc : functionCalls)
-        ret[fc.callId].push_back(&fc);
-    return ret;
+    std::call_once(mCallsMapFlag, [this]() {
+        for (const CTU::FileInfo::NestedCall &nc : nestedCalls)
+            mCallsMap[nc.callId].push_back(&nc);
+        for (const CTU::FileInfo::FunctionCall &fc : functionCalls)
+            mCallsMap[fc.callId].push_back(&fc);
+    });
+    return mCallsMap;
 }
 
 std::list<CTU::FileInfo::UnsafeUsage> CTU::loadUnsafeUsageListFromXml(const tinyxml2::XMLElement *xmlElement)
@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -143,7 +144,12 @@ namespace CTU {
         std::list<NestedCall> nestedCalls;
 
         void loadFromXml(const tinyxml2::XMLElement *xmlElement);
-        std::map<std::string, std::list<const CallBase *>> getCallsMap() const;
+
+        /**
+         * Get the calls indexed by the id of the called function. The index is built on the
+         * first call and then shared by all checks, the calls must not be changed after that.
+         */
+        const std::map<std::string, std::list<const CallBase *>> &getCallsMap() const;
 
         static std::list<ErrorMessage::FileLocation> getErrorPath(InvalidValueType invalidValue,
                                                                   const UnsafeUsage &unsafeUsage,
@@ -153,6 +159,10 @@ namespace CTU {
                                                                   bool warning,
                                                                   int maxCtuDepth,
                                                                   ValueFlow::Value::UnknownFunctionReturn *unknownFunctionReturn = nullptr);
+
+    private:
+        mutable std::once_flag mCallsMapFlag;
+        mutable std::map<std::string, std::list<const CallBase *>> mCallsMap;
     };
 
     CPPCHECKLIB std::string toString(const std::list<FileInfo::UnsafeUsage> &unsafeUsage);
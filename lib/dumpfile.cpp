@@ -0,0 +1,262 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dumpfile.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ios>
+#include <utility>
+
+constexpr char BinaryDumpBuffer::magic[];
+constexpr std::uint32_t BinaryDumpBuffer::version;
+
+static void appendValue(std::string &out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out += static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+static void appendUtf8(std::string &out, unsigned long c)
+{
+    if (c < 0x80) {
+        out += static_cast<char>(c);
+    } else if (c < 0x800) {
+        out += static_cast<char>(0xc0 | (c >> 6));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+    } else if (c < 0x10000) {
+        out += static_cast<char>(0xe0 | (c >> 12));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+    } else {
+        out += static_cast<char>(0xf0 | ((c >> 18) & 0x07));
+        out += static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+    }
+}
+
+/** unescape an attribute value, the whitespaces are normalized like by XML parsers */
+static std::string unescape(const char *begin, const char *end)
+{
+    std::string ret;
+    ret.reserve(end - begin);
+    for (const char *p = begin; p < end; ++p) {
+        if (*p == '\t' || *p == '\n' || *p == '\r') {
+            ret += ' ';
+            continue;
+        }
+        if (*p != '&') {
+            ret += *p;
+            continue;
+        }
+        const char *semicolon = std::find(p, end, ';');
+        const std::string entity(p + 1, semicolon);
+        if (entity == "lt")
+            ret += '<';
+        else if (entity == "gt")
+            ret += '>';
+        else if (entity == "amp")
+            ret += '&';
+        else if (entity == "quot")
+            ret += '\"';
+        else if (entity == "apos")
+            ret += '\'';
+        else if (entity.size() > 2 && entity[0] == '#' && entity[1] == 'x')
+            appendUtf8(ret, std::strtoul(entity.c_str() + 2, nullptr, 16));
+        else if (entity.size() > 1 && entity[0] == '#')
+            appendUtf8(ret, std::strtoul(entity.c_str() + 1, nullptr, 10));
+        else {
+            ret += *p;
+            continue;
+        }
+        p = semicolon;
+    }
+    return ret;
+}
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+BinaryDumpBuffer::BinaryDumpBuffer()
+    : mBuffer(1 << 16)
+{
+    setp(mBuffer.data(), mBuffer.data() + mBuffer.size());
+    intern("");
+}
+
+BinaryDumpBuffer::int_type BinaryDumpBuffer::overflow(int_type c)
+{
+    sync();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int BinaryDumpBuffer::sync()
+{
+    mPending.append(pbase(), pptr());
+    setp(mBuffer.data(), mBuffer.data() + mBuffer.size());
+    convert();
+    return 0;
+}
+
+void BinaryDumpBuffer::convert()
+{
+    const char * const data = mPending.data();
+    const char * const end = data + mPending.size();
+    const char *pos = data;
+    for (;;) {
+        // the text between the tags is not part of the dump
+        const char *begin = std::find(pos, end, '<');
+        if (begin == end) {
+            pos = end;
+            break;
+        }
+        const char *tagEnd = begin + 1;
+        char quote = '\0';
+        while (tagEnd < end && (quote || *tagEnd != '>')) {
+            if (quote && *tagEnd == quote)
+                quote = '\0';
+            else if (!quote && (*tagEnd == '\"' || *tagEnd == '\''))
+                quote = *tagEnd;
+            ++tagEnd;
+        }
+        if (tagEnd == end) {
+            pos = begin;
+            break;
+        }
+        convertTag(begin, tagEnd);
+        pos = tagEnd + 1;
+    }
+    mPending.erase(0, pos - data);
+}
+
+void BinaryDumpBuffer::convertTag(const char *begin, const char *end)
+{
+    // declaration, comment
+    if (begin[1] == '?' || begin[1] == '!')
+        return;
+    if (begin[1] == '/') {
+        mItems.push_back(0);
+        return;
+    }
+
+    const char *p = begin + 1;
+    const char *nameEnd = p;
+    while (nameEnd < end && !isSpace(*nameEnd) && *nameEnd != '/')
+        ++nameEnd;
+    mItems.push_back(intern(std::string(p, nameEnd)));
+    const std::size_t countIndex = mItems.size();
+    mItems.push_back(0);
+    p = nameEnd;
+
+    bool empty = false;
+    for (;;) {
+        while (p < end && isSpace(*p))
+            ++p;
+        if (p == end)
+            break;
+        if (*p == '/') {
+            empty = true;
+            break;
+        }
+        const char *attrEnd = p;
+        while (attrEnd < end && *attrEnd != '=' && !isSpace(*attrEnd))
+            ++attrEnd;
+        const char *quote = attrEnd;
+        while (quote < end && *quote != '\"' && *quote != '\'')
+            ++quote;
+        if (quote == end)
+            break;
+        const char *valueEnd = std::find(quote + 1, end, *quote);
+        mItems.push_back(intern(std::string(p, attrEnd)));
+        mItems.push_back(intern(unescape(quote + 1, valueEnd)));
+        ++mItems[countIndex];
+        p = valueEnd + 1;
+    }
+    if (empty)
+        mItems.push_back(0);
+}
+
+std::uint32_t BinaryDumpBuffer::intern(const std::string &str)
+{
+    const auto it = mStringIndex.find(str);
+    if (it != mStringIndex.end())
+        return it->second;
+    const auto index = static_cast<std::uint32_t>(mStringIndex.size());
+    mStringIndex.emplace(str, index);
+    mStrings += str;
+    mStrings += '\0';
+    return index;
+}
+
+std::string BinaryDumpBuffer::data()
+{
+    sync();
+    std::string ret(magic, sizeof(magic) - 1);
+    appendValue(ret, version);
+    appendValue(ret, static_cast<std::uint32_t>(mItems.size()));
+    appendValue(ret, static_cast<std::uint32_t>(mStrings.size()));
+    ret.reserve(ret.size() + 4 * mItems.size() + mStrings.size());
+    for (const std::uint32_t item : mItems)
+        appendValue(ret, item);
+    ret += mStrings;
+    return ret;
+}
+
+DumpFile::DumpFile()
+    : std::ostream(nullptr)
+{}
+
+DumpFile::~DumpFile()
+{
+    close();
+}
+
+void DumpFile::open(const std::string &filename, bool binary)
+{
+    mIsBinary = binary;
+    mFile.open(filename, binary ? (std::ios::out | std::ios::binary) : std::ios::out);
+    if (!mFile.is_open())
+        return;
+    rdbuf(binary ? static_cast<std::streambuf *>(&mBinary) : mFile.rdbuf());
+}
+
+bool DumpFile::is_open() const
+{
+    return mFile.is_open();
+}
+
+void DumpFile::close()
+{
+    if (!mFile.is_open())
+        return;
+    flush();
+    if (mIsBinary) {
+        const std::string data = mBinary.data();
+        mFile.write(data.data(), data.size());
+    }
+    rdbuf(nullptr);
+    mFile.close();
+}
@@ -0,0 +1,98 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef dumpfileH
+#define dumpfileH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Converts the XML of a dump to the binary dump format while it is written.
+ *
+ * The binary format starts with the magic string "CPPCHECKDUMP" and the 32-bit values version,
+ * number of items and size of the string table, followed by the items and the string table.
+ * An element is stored as the items: tag, number of attributes and the name and value of each
+ * attribute. The item 0 ends the current element. All other items are indices in the string
+ * table, every tag, name and value is stored only once. The string table contains the
+ * zero-terminated strings, the first string is empty. All values are little endian.
+ */
+class CPPCHECKLIB BinaryDumpBuffer : public std::streambuf {
+public:
+    static constexpr char magic[] = "CPPCHECKDUMP";
+    static constexpr std::uint32_t version = 1;
+
+    BinaryDumpBuffer();
+
+    /** @return the binary dump of the XML that has been written */
+    std::string data();
+
+protected:
+    int_type overflow(int_type c) override;
+    int sync() override;
+
+private:
+    /** convert the written XML */
+    void convert();
+    void convertTag(const char *begin, const char *end);
+    std::uint32_t intern(const std::string &str);
+
+    std::vector<char> mBuffer;
+    /** XML that has not been converted yet */
+    std::string mPending;
+    std::vector<std::uint32_t> mItems;
+    std::string mStrings;
+    std::unordered_map<std::string, std::uint32_t> mStringIndex;
+};
+
+/**
+ * @brief Output file for the dump, the XML is written as is or in the binary dump format.
+ */
+class CPPCHECKLIB DumpFile : public std::ostream {
+public:
+    DumpFile();
+    ~DumpFile() override;
+
+    DumpFile(const DumpFile &) = delete;
+    DumpFile &operator=(const DumpFile &) = delete;
+
+    void open(const std::string &filename, bool binary);
+    bool is_open() const;
+    void close();
+
+private:
+    std::ofstream mFile;
+    BinaryDumpBuffer mBinary;
+    bool mIsBinary{};
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // dumpfileH
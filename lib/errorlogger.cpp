@@ -35,6 +35,7 @@
 #include <cstring>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -746,6 +747,33 @@ std::string ErrorMessage::FileLocation::stringify(bool addcolumn) const
     return str;
 }
 
+void BufferedErrorLogger::reportOut(const std::string &outmsg, Color c)
+{
+    std::lock_guard<std::mutex> lg(mSync);
+    mMessages.emplace_back([=](ErrorLogger &errorLogger) {
+        errorLogger.reportOut(outmsg, c);
+    });
+}
+
+void BufferedErrorLogger::reportErr(const ErrorMessage &msg)
+{
+    std::lock_guard<std::mutex> lg(mSync);
+    mMessages.emplace_back([=](ErrorLogger &errorLogger) {
+        errorLogger.reportErr(msg);
+    });
+}
+
+void BufferedErrorLogger::forward(ErrorLogger &errorLogger)
+{
+    std::list<std::function<void(ErrorLogger&)>> messages;
+    {
+        std::lock_guard<std::mutex> lg(mSync);
+        messages.swap(mMessages);
+    }
+    for (const auto& m : messages)
+        m(errorLogger);
+}
+
 std::string ErrorLogger::toxml(const std::string &str)
 {
     std::string xml;
@@ -26,7 +26,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <list>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -282,6 +284,23 @@ private:
     static const std::set<std::string> mCriticalErrorIds;
 };
 
+/**
+ * Collects the messages that are reported by another thread so they can be
+ * forwarded in a deterministic order.
+ */
+class CPPCHECKLIB BufferedErrorLogger : public ErrorLogger {
+public:
+    void reportOut(const std::string &outmsg, Color c) override;
+    void reportErr(const ErrorMessage &msg) override;
+
+    /** report the collected messages to the given logger */
+    void forward(ErrorLogger &errorLogger);
+
+private:
+    std::mutex mSync;
+    std::list<std::function<void(ErrorLogger&)>> mMessages;
+};
+
 /** Replace substring. Example replaceStr("1,NR,3", "NR", "2") => "1,2,3" */
 std::string replaceStr(std::string s, const std::string &from, const std::string &to);
 
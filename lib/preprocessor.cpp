@@ -33,8 +33,15 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 
 #include <simplecpp.h>
@@ -775,12 +782,306 @@ void Preprocessor::handleErrors(const simplecpp::OutputList& outputList, bool th
     }
 }
 
+namespace {
+    /** Raw tokens of a file and the messages that were reported when it was tokenized */
+    struct CachedFile {
+        CachedFile(const std::string &filename, const std::string &content, std::size_t hash)
+            : size(content.size())
+            , hash(hash)
+            , tokens(content.data(), content.size(), files, filename, &outputList)
+        {}
+
+        CachedFile(std::size_t size, std::size_t hash)
+            : size(size)
+            , hash(hash)
+            , tokens(files)
+        {}
+
+        const std::size_t size;
+        const std::size_t hash;
+        std::vector<std::string> files;
+        simplecpp::OutputList outputList;
+        simplecpp::TokenList tokens;
+    };
+
+    /**
+     * Raw tokens of all included files, shared by all translation units that are checked in this process.
+     * The entries are never modified so they can be copied without holding the lock.
+     */
+    std::mutex headerCacheSync;
+    std::unordered_map<std::string, std::shared_ptr<const CachedFile>> headerCache;
+
+    /**
+     * Binary serialization of a CachedFile in the build dir. The file name is the content hash so the
+     * raw tokens can be reused by later runs even if the file is analyzed again.
+     * The data is only read back by the same cppcheck binary on the same machine so native endianness is used.
+     */
+    namespace RawTokensFile {
+        constexpr char magic[] = "cppcheck-rawtokens";
+        constexpr std::uint32_t version = 1;
+
+        std::string getFilename(const std::string &buildDir, std::size_t hash)
+        {
+            return Path::join(buildDir, std::to_string(hash) + ".rawtokens");
+        }
+
+        template<class T>
+        void writeValue(std::ostream &out, T value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+
+        void writeString(std::ostream &out, const std::string &str)
+        {
+            writeValue<std::uint32_t>(out, str.size());
+            out.write(str.data(), str.size());
+        }
+
+        void writeLocation(std::ostream &out, const simplecpp::Location &location)
+        {
+            writeValue<std::uint32_t>(out, location.fileIndex);
+            writeValue<std::uint32_t>(out, location.line);
+            writeValue<std::uint32_t>(out, location.col);
+        }
+
+        template<class T>
+        bool readValue(std::istream &in, T &value)
+        {
+            return !!in.read(reinterpret_cast<char *>(&value), sizeof(value));
+        }
+
+        bool readString(std::istream &in, std::string &str)
+        {
+            std::uint32_t len;
+            if (!readValue(in, len))
+                return false;
+            str.resize(len);
+            return !!in.read(&str[0], len);
+        }
+
+        bool readLocation(std::istream &in, simplecpp::Location &location, std::size_t filesCount)
+        {
+            std::uint32_t fileIndex, line, col;
+            if (!readValue(in, fileIndex) || !readValue(in, line) || !readValue(in, col) || fileIndex >= filesCount)
+                return false;
+            location.fileIndex = fileIndex;
+            location.line = line;
+            location.col = col;
+            return true;
+        }
+
+        void write(const std::string &buildDir, const CachedFile &cachedFile)
+        {
+            std::ofstream fout(getFilename(buildDir, cachedFile.hash), std::ios::binary);
+            if (!fout.is_open())
+                return;
+
+            fout.write(magic, sizeof(magic));
+            writeValue(fout, version);
+            writeValue<std::uint64_t>(fout, cachedFile.size);
+            writeValue<std::uint64_t>(fout, cachedFile.hash);
+
+            writeValue<std::uint32_t>(fout, cachedFile.files.size());
+            for (const std::string &f : cachedFile.files)
+                writeString(fout, f);
+
+            writeValue<std::uint32_t>(fout, cachedFile.outputList.size());
+            for (const simplecpp::Output &output : cachedFile.outputList) {
+                writeValue<std::uint32_t>(fout, output.type);
+                writeLocation(fout, output.location);
+                writeString(fout, output.msg);
+            }
+
+            std::uint32_t tokensCount = 0;
+            for (const simplecpp::Token *tok = cachedFile.tokens.cfront(); tok; tok = tok->next)
+                ++tokensCount;
+            writeValue(fout, tokensCount);
+            for (const simplecpp::Token *tok = cachedFile.tokens.cfront(); tok; tok = tok->next) {
+                writeString(fout, tok->str());
+                writeLocation(fout, tok->location);
+                writeValue<std::uint8_t>(fout, tok->whitespaceahead);
+            }
+
+            // a file without the trailing magic was not completely written
+            fout.write(magic, sizeof(magic));
+        }
+
+        std::shared_ptr<const CachedFile> read(const std::string &buildDir, const std::string &filename, std::size_t size, std::size_t hash)
+        {
+            std::ifstream fin(getFilename(buildDir, hash), std::ios::binary);
+            if (!fin.is_open())
+                return nullptr;
+
+            std::array<char, sizeof(magic)> m;
+            std::uint32_t v;
+            std::uint64_t s, h;
+            if (!fin.read(m.data(), m.size()) || std::memcmp(m.data(), magic, m.size()) != 0)
+                return nullptr;
+            if (!readValue(fin, v) || v != version || !readValue(fin, s) || s != size || !readValue(fin, h) || h != hash)
+                return nullptr;
+
+            auto cachedFile = std::make_shared<CachedFile>(size, hash);
+
+            std::uint32_t count;
+            if (!readValue(fin, count) || count == 0)
+                return nullptr;
+            cachedFile->files.resize(count);
+            for (std::string &f : cachedFile->files) {
+                if (!readString(fin, f))
+                    return nullptr;
+            }
+            // the content might have been stored by another file
+            cachedFile->files[0] = filename;
+
+            if (!readValue(fin, count))
+                return nullptr;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                std::uint32_t type;
+                simplecpp::Output output(cachedFile->files);
+                if (!readValue(fin, type) || !readLocation(fin, output.location, cachedFile->files.size()) || !readString(fin, output.msg))
+                    return nullptr;
+                output.type = static_cast<simplecpp::Output::Type>(type);
+                cachedFile->outputList.push_back(std::move(output));
+            }
+
+            if (!readValue(fin, count))
+                return nullptr;
+            std::string str;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                simplecpp::Location location(cachedFile->files);
+                std::uint8_t whitespaceahead;
+                if (!readString(fin, str) || !readLocation(fin, location, cachedFile->files.size()) || !readValue(fin, whitespaceahead))
+                    return nullptr;
+                cachedFile->tokens.push_back(new simplecpp::Token(str, location, whitespaceahead != 0));
+            }
+
+            if (!fin.read(m.data(), m.size()) || std::memcmp(m.data(), magic, m.size()) != 0)
+                return nullptr;
+            return cachedFile;
+        }
+    }
+
+    /** Get the raw tokens of a file from the build dir or tokenize it and store them in the build dir */
+    std::shared_ptr<const CachedFile> createCachedFile(const std::string &filename, const std::string &content, std::size_t hash, const std::string &buildDir)
+    {
+        if (buildDir.empty())
+            return std::make_shared<const CachedFile>(filename, content, hash);
+        std::shared_ptr<const CachedFile> cachedFile = RawTokensFile::read(buildDir, filename, content.size(), hash);
+        if (!cachedFile) {
+            cachedFile = std::make_shared<const CachedFile>(filename, content, hash);
+            RawTokensFile::write(buildDir, *cachedFile);
+        }
+        return cachedFile;
+    }
+
+    /** copy cached tokens, the file indexes are translated to the files of the translation unit */
+    simplecpp::TokenList *copyCachedFile(const CachedFile &cachedFile, std::vector<std::string> &filenames, simplecpp::OutputList *outputList)
+    {
+        std::vector<unsigned int> fileIndexes;
+        fileIndexes.reserve(cachedFile.files.size());
+        for (const std::string &f : cachedFile.files) {
+            const auto it = std::find(filenames.cbegin(), filenames.cend(), f);
+            fileIndexes.push_back(it - filenames.cbegin());
+            if (it == filenames.cend())
+                filenames.push_back(f);
+        }
+
+        const auto copyLocation = [&](simplecpp::Location &dest, const simplecpp::Location &src) {
+            dest.fileIndex = fileIndexes[src.fileIndex];
+            dest.line = src.line;
+            dest.col = src.col;
+        };
+
+        if (outputList) {
+            for (const simplecpp::Output &output : cachedFile.outputList) {
+                simplecpp::Output output2(filenames, output.type, output.msg);
+                copyLocation(output2.location, output.location);
+                outputList->push_back(std::move(output2));
+            }
+        }
+
+        auto *tokens = new simplecpp::TokenList(filenames);
+        for (const simplecpp::Token *tok = cachedFile.tokens.cfront(); tok; tok = tok->next) {
+            simplecpp::Location location(filenames);
+            copyLocation(location, tok->location);
+            auto *tok2 = new simplecpp::Token(tok->str(), location, tok->whitespaceahead);
+            tok2->op = tok->op;
+            tok2->comment = tok->comment;
+            tok2->name = tok->name;
+            tok2->number = tok->number;
+            tokens->push_back(tok2);
+        }
+        return tokens;
+    }
+
+    bool readFile(const std::string &filename, std::string &content)
+    {
+        std::ifstream fin(filename, std::ios::binary);
+        if (!fin.is_open())
+            return false;
+        std::ostringstream ostr;
+        ostr << fin.rdbuf();
+        content = ostr.str();
+        return true;
+    }
+
+    /** Reuses the raw tokens of files that were already included by another translation unit */
+    class HeaderCacheLoader : public simplecpp::FileLoader {
+    public:
+        HeaderCacheLoader(std::string buildDir, std::size_t &hits, std::size_t &misses) : mBuildDir(std::move(buildDir)), mHits(hits), mMisses(misses) {}
+
+        simplecpp::TokenList *load(const std::string &filename, std::vector<std::string> &filenames, simplecpp::OutputList *outputList) override
+        {
+            std::string content;
+            if (!readFile(filename, content))
+                return new simplecpp::TokenList(filename, filenames, outputList);
+            const std::size_t hash = std::hash<std::string>{}(content);
+
+            std::shared_ptr<const CachedFile> cachedFile;
+            {
+                std::lock_guard<std::mutex> lg(headerCacheSync);
+                const auto it = headerCache.find(filename);
+                if (it != headerCache.cend() && it->second->size == content.size() && it->second->hash == hash)
+                    cachedFile = it->second;
+            }
+            if (cachedFile) {
+                ++mHits;
+            } else {
+                ++mMisses;
+                cachedFile = createCachedFile(filename, content, hash, mBuildDir);
+                std::lock_guard<std::mutex> lg(headerCacheSync);
+                headerCache[filename] = cachedFile;
+            }
+
+            return copyCachedFile(*cachedFile, filenames, outputList);
+        }
+
+    private:
+        const std::string mBuildDir;
+        std::size_t &mHits;
+        std::size_t &mMisses;
+    };
+}
+
+simplecpp::TokenList Preprocessor::createRawTokens(const std::string &filename, std::vector<std::string> &files, simplecpp::OutputList *outputList, const std::string &buildDir)
+{
+    std::string content;
+    if (buildDir.empty() || !readFile(filename, content))
+        return {filename, files, outputList};
+
+    // source files are not kept in memory, they are usually only checked once
+    const std::shared_ptr<const CachedFile> cachedFile = createCachedFile(filename, content, std::hash<std::string>{}(content), buildDir);
+    const std::unique_ptr<simplecpp::TokenList> tokens(copyCachedFile(*cachedFile, files, outputList));
+    return std::move(*tokens);
+}
+
 bool Preprocessor::loadFiles(const simplecpp::TokenList &rawtokens, std::vector<std::string> &files)
 {
     const simplecpp::DUI dui = createDUI(mSettings, "", mLang);
 
     simplecpp::OutputList outputList;
-    mTokenLists = simplecpp::load(rawtokens, files, dui, &outputList);
+    HeaderCacheLoader headerCacheLoader(mSettings.buildDir, mHeaderCacheHits, mHeaderCacheMisses);
+    mTokenLists = simplecpp::load(rawtokens, files, dui, &outputList, &headerCacheLoader);
     handleErrors(outputList, false);
     return !hasErrors(outputList);
 }
@@ -122,6 +122,22 @@ public:
 
     bool loadFiles(const simplecpp::TokenList &rawtokens, std::vector<std::string> &files);
 
+    /** Number of included files that loadFiles() took from the header cache */
+    std::size_t getHeaderCacheHits() const {
+        return mHeaderCacheHits;
+    }
+
+    /** Number of included files that loadFiles() had to tokenize */
+    std::size_t getHeaderCacheMisses() const {
+        return mHeaderCacheMisses;
+    }
+
+    /**
+     * Tokenize a source file. When a build dir is used the raw tokens are stored there
+     * and reused as long as the file content is unchanged.
+     */
+    static simplecpp::TokenList createRawTokens(const std::string &filename, std::vector<std::string> &files, simplecpp::OutputList *outputList, const std::string &buildDir);
+
     void removeComments(simplecpp::TokenList &tokens);
 
     static void setPlatformInfo(simplecpp::TokenList &tokens, const Settings& settings);
@@ -186,6 +202,10 @@ private:
     /** simplecpp tracking info */
     std::list<simplecpp::MacroUsage> mMacroUsage;
     std::list<simplecpp::IfCond> mIfCond;
+
+    /** header cache statistics */
+    std::size_t mHeaderCacheHits{};
+    std::size_t mHeaderCacheMisses{};
 };
 
 /// @}
@@ -0,0 +1,539 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ruleengine.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <queue>
+
+#ifdef HAVE_RULES
+#include <mutex>
+
+#ifdef _WIN32
+#define PCRE_STATIC
+#endif
+#include <pcre.h>
+#endif
+
+namespace {
+    /** @return the position after the character class that starts at pos, std::string::npos if it is not closed */
+    std::string::size_type skipClass(const std::string &pattern, std::string::size_type pos)
+    {
+        // the first ']' of a class is a literal
+        pos += (pos + 1 < pattern.size() && pattern[pos + 1] == '^') ? 2 : 1;
+        if (pos < pattern.size() && pattern[pos] == ']')
+            ++pos;
+        while (pos < pattern.size() && pattern[pos] != ']')
+            pos += (pattern[pos] == '\\') ? 2 : 1;
+        return pos < pattern.size() ? pos + 1 : std::string::npos;
+    }
+
+    /** @return the position after the group that starts at pos, std::string::npos if it is not closed */
+    std::string::size_type skipGroup(const std::string &pattern, std::string::size_type pos)
+    {
+        int level = 0;
+        while (pos < pattern.size()) {
+            const char c = pattern[pos];
+            if (c == '\\') {
+                pos += 2;
+                continue;
+            }
+            if (c == '[') {
+                pos = skipClass(pattern, pos);
+                continue;
+            }
+            if (c == '(')
+                ++level;
+            else if (c == ')' && --level == 0)
+                return pos + 1;
+            ++pos;
+        }
+        return std::string::npos;
+    }
+
+    /** @return the minimum of a {n}, {n,} or {n,m} quantifier that starts at pos, -1 if it is not a quantifier */
+    int quantifierMin(const std::string &pattern, std::string::size_type pos, std::string::size_type &end)
+    {
+        std::string::size_type i = pos + 1;
+        int min = 0;
+        const std::string::size_type digits = i;
+        while (i < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[i])))
+            min = std::min(min * 10 + (pattern[i++] - '0'), 1000);
+        if (i == digits)
+            return -1;
+        if (i < pattern.size() && pattern[i] == ',') {
+            ++i;
+            while (i < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[i])))
+                ++i;
+        }
+        if (i >= pattern.size() || pattern[i] != '}')
+            return -1;
+        end = i + 1;
+        return min;
+    }
+}
+
+std::vector<std::string> RulePrefilter::requiredLiterals(const std::string &pattern)
+{
+    std::vector<std::string> literals;
+    std::string literal;
+    // the last character of the literal can be made optional by a quantifier
+    bool quantifiable = false;
+
+    const auto addLiteral = [&]() {
+        if (!literal.empty() && std::find(literals.cbegin(), literals.cend(), literal) == literals.cend())
+            literals.push_back(literal);
+        literal.clear();
+        quantifiable = false;
+    };
+    const auto removeQuantified = [&]() {
+        if (quantifiable)
+            literal.pop_back();
+        addLiteral();
+    };
+
+    std::string::size_type pos = 0;
+    while (pos < pattern.size()) {
+        const char c = pattern[pos];
+        switch (c) {
+        case '\\': {
+            if (pos + 1 >= pattern.size())
+                return {};
+            const char escaped = pattern[pos + 1];
+            pos += 2;
+            if (std::isalnum(static_cast<unsigned char>(escaped))) {
+                // character types and assertions, the other escapes are not analyzed
+                if (!std::strchr("sSdDwWbBhHvVRNXAzZG", escaped))
+                    return {};
+                addLiteral();
+            } else {
+                literal += escaped;
+                quantifiable = true;
+            }
+            break;
+        }
+        case '|':
+            // the alternatives are not analyzed
+            return {};
+        case '(': {
+            // options like (?i) change the meaning of the rest of the pattern
+            if (pos + 2 < pattern.size() && pattern[pos + 1] == '?' && !std::strchr(":=!<>P#|", pattern[pos + 2]))
+                return {};
+            addLiteral();
+            pos = skipGroup(pattern, pos);
+            if (pos == std::string::npos)
+                return {};
+            break;
+        }
+        case ')':
+            return {};
+        case '[':
+            addLiteral();
+            pos = skipClass(pattern, pos);
+            if (pos == std::string::npos)
+                return {};
+            break;
+        case '.':
+        case '^':
+        case '$':
+            addLiteral();
+            ++pos;
+            break;
+        case '*':
+        case '?':
+            removeQuantified();
+            ++pos;
+            break;
+        case '+':
+            addLiteral();
+            ++pos;
+            break;
+        case '{': {
+            std::string::size_type end;
+            const int min = quantifierMin(pattern, pos, end);
+            if (min >= 0) {
+                if (min == 0)
+                    removeQuantified();
+                else
+                    addLiteral();
+                pos = end;
+                break;
+            }
+            literal += c;
+            quantifiable = true;
+            ++pos;
+            break;
+        }
+        default:
+            literal += c;
+            quantifiable = true;
+            ++pos;
+            break;
+        }
+    }
+    addLiteral();
+    return literals;
+}
+
+RulePrefilter::RulePrefilter(const std::vector<std::string> &patterns)
+{
+    // the trie of the literals, the transitions of the automaton are filled in afterwards
+    mTransitions.assign(256, -1);
+    mOutputs.emplace_back();
+
+    std::map<std::string, std::size_t> literalIds;
+    for (const std::string &pattern : patterns) {
+        std::vector<std::size_t> ids;
+        for (const std::string &literal : requiredLiterals(pattern)) {
+            const auto it = literalIds.find(literal);
+            if (it != literalIds.cend()) {
+                ids.push_back(it->second);
+                continue;
+            }
+            const std::size_t id = literalIds.size();
+            literalIds.emplace(literal, id);
+            ids.push_back(id);
+
+            std::size_t state = 0;
+            for (const char c : literal) {
+                int &next = mTransitions[state * 256 + static_cast<unsigned char>(c)];
+                if (next < 0) {
+                    next = static_cast<int>(mOutputs.size());
+                    mTransitions.insert(mTransitions.end(), 256, -1);
+                    mOutputs.emplace_back();
+                }
+                // the vector might have been reallocated
+                state = static_cast<std::size_t>(mTransitions[state * 256 + static_cast<unsigned char>(c)]);
+            }
+            mOutputs[state].push_back(id);
+        }
+        mPatternLiterals.push_back(std::move(ids));
+    }
+    mLiteralCount = literalIds.size();
+
+    // breadth first construction of the failure transitions
+    std::vector<std::size_t> failure(mOutputs.size(), 0);
+    std::queue<std::size_t> states;
+    for (int c = 0; c < 256; ++c) {
+        int &next = mTransitions[c];
+        if (next < 0)
+            next = 0;
+        else
+            states.push(static_cast<std::size_t>(next));
+    }
+    while (!states.empty()) {
+        const std::size_t state = states.front();
+        states.pop();
+        const std::vector<std::size_t> &failureOutputs = mOutputs[failure[state]];
+        mOutputs[state].insert(mOutputs[state].end(), failureOutputs.cbegin(), failureOutputs.cend());
+        for (int c = 0; c < 256; ++c) {
+            int &next = mTransitions[state * 256 + c];
+            const int failureNext = mTransitions[failure[state] * 256 + c];
+            if (next < 0) {
+                next = failureNext;
+            } else {
+                failure[next] = static_cast<std::size_t>(failureNext);
+                states.push(static_cast<std::size_t>(next));
+            }
+        }
+    }
+}
+
+std::vector<bool> RulePrefilter::candidates(const std::string &str) const
+{
+    std::vector<bool> found(mLiteralCount, false);
+    std::size_t foundCount = 0;
+    std::size_t state = 0;
+    for (const char c : str) {
+        state = static_cast<std::size_t>(mTransitions[state * 256 + static_cast<unsigned char>(c)]);
+        for (const std::size_t id : mOutputs[state]) {
+            if (!found[id]) {
+                found[id] = true;
+                ++foundCount;
+            }
+        }
+        if (foundCount == mLiteralCount)
+            break;
+    }
+
+    std::vector<bool> ret;
+    ret.reserve(mPatternLiterals.size());
+    for (const std::vector<std::size_t> &ids : mPatternLiterals) {
+        ret.push_back(std::all_of(ids.cbegin(), ids.cend(), [&](std::size_t id) {
+            return found[id];
+        }));
+    }
+    return ret;
+}
+
+#ifdef HAVE_RULES
+static const char * pcreErrorCodeToString(const int pcreExecRet)
+{
+    switch (pcreExecRet) {
+    case PCRE_ERROR_NULL:
+        return "Either code or subject was passed as NULL, or ovector was NULL "
+               "and ovecsize was not zero (PCRE_ERROR_NULL)";
+    case PCRE_ERROR_BADOPTION:
+        return "An unrecognized bit was set in the options argument (PCRE_ERROR_BADOPTION)";
+    case PCRE_ERROR_BADMAGIC:
+        return "PCRE stores a 4-byte \"magic number\" at the start of the compiled code, "
+               "to catch the case when it is passed a junk pointer and to detect when a "
+               "pattern that was compiled in an environment of one endianness is run in "
+               "an environment with the other endianness. This is the error that PCRE "
+               "gives when the magic number is not present (PCRE_ERROR_BADMAGIC)";
+    case PCRE_ERROR_UNKNOWN_NODE:
+        return "While running the pattern match, an unknown item was encountered in the "
+               "compiled pattern. This error could be caused by a bug in PCRE or by "
+               "overwriting of the compiled pattern (PCRE_ERROR_UNKNOWN_NODE)";
+    case PCRE_ERROR_NOMEMORY:
+        return "If a pattern contains back references, but the ovector that is passed "
+               "to pcre_exec() is not big enough to remember the referenced substrings, "
+               "PCRE gets a block of memory at the start of matching to use for this purpose. "
+               "If the call via pcre_malloc() fails, this error is given. The memory is "
+               "automatically freed at the end of matching. This error is also given if "
+               "pcre_stack_malloc() fails in pcre_exec(). "
+               "This can happen only when PCRE has been compiled with "
+               "--disable-stack-for-recursion (PCRE_ERROR_NOMEMORY)";
+    case PCRE_ERROR_NOSUBSTRING:
+        return "This error is used by the pcre_copy_substring(), pcre_get_substring(), "
+               "and pcre_get_substring_list() functions (see below). "
+               "It is never returned by pcre_exec() (PCRE_ERROR_NOSUBSTRING)";
+    case PCRE_ERROR_MATCHLIMIT:
+        return "The backtracking limit, as specified by the match_limit field in a pcre_extra "
+               "structure (or defaulted) was reached. "
+               "See the description above (PCRE_ERROR_MATCHLIMIT)";
+    case PCRE_ERROR_CALLOUT:
+        return "This error is never generated by pcre_exec() itself. "
+               "It is provided for use by callout functions that want to yield a distinctive "
+               "error code. See the pcrecallout documentation for details (PCRE_ERROR_CALLOUT)";
+    case PCRE_ERROR_BADUTF8:
+        return "A string that contains an invalid UTF-8 byte sequence was passed as a subject, "
+               "and the PCRE_NO_UTF8_CHECK option was not set. If the size of the output vector "
+               "(ovecsize) is at least 2, the byte offset to the start of the the invalid UTF-8 "
+               "character is placed in the first element, and a reason code is placed in the "
+               "second element. The reason codes are listed in the following section. For "
+               "backward compatibility, if PCRE_PARTIAL_HARD is set and the problem is a truncated "
+               "UTF-8 character at the end of the subject (reason codes 1 to 5), "
+               "PCRE_ERROR_SHORTUTF8 is returned instead of PCRE_ERROR_BADUTF8";
+    case PCRE_ERROR_BADUTF8_OFFSET:
+        return "The UTF-8 byte sequence that was passed as a subject was checked and found to "
+               "be valid (the PCRE_NO_UTF8_CHECK option was not set), but the value of "
+               "startoffset did not point to the beginning of a UTF-8 character or the end of "
+               "the subject (PCRE_ERROR_BADUTF8_OFFSET)";
+    case PCRE_ERROR_PARTIAL:
+        return "The subject string did not match, but it did match partially. See the "
+               "pcrepartial documentation for details of partial matching (PCRE_ERROR_PARTIAL)";
+    case PCRE_ERROR_BADPARTIAL:
+        return "This code is no longer in use. It was formerly returned when the PCRE_PARTIAL "
+               "option was used with a compiled pattern containing items that were not supported "
+               "for partial matching. From release 8.00 onwards, there are no restrictions on "
+               "partial matching (PCRE_ERROR_BADPARTIAL)";
+    case PCRE_ERROR_INTERNAL:
+        return "An unexpected internal error has occurred. This error could be caused by a bug "
+               "in PCRE or by overwriting of the compiled pattern (PCRE_ERROR_INTERNAL)";
+    case PCRE_ERROR_BADCOUNT:
+        return "This error is given if the value of the ovecsize argument is negative "
+               "(PCRE_ERROR_BADCOUNT)";
+    case PCRE_ERROR_RECURSIONLIMIT:
+        return "The internal recursion limit, as specified by the match_limit_recursion "
+               "field in a pcre_extra structure (or defaulted) was reached. "
+               "See the description above (PCRE_ERROR_RECURSIONLIMIT)";
+    case PCRE_ERROR_DFA_UITEM:
+        return "PCRE_ERROR_DFA_UITEM";
+    case PCRE_ERROR_DFA_UCOND:
+        return "PCRE_ERROR_DFA_UCOND";
+    case PCRE_ERROR_DFA_WSSIZE:
+        return "PCRE_ERROR_DFA_WSSIZE";
+    case PCRE_ERROR_DFA_RECURSE:
+        return "PCRE_ERROR_DFA_RECURSE";
+    case PCRE_ERROR_NULLWSLIMIT:
+        return "PCRE_ERROR_NULLWSLIMIT";
+    case PCRE_ERROR_BADNEWLINE:
+        return "An invalid combination of PCRE_NEWLINE_xxx options was "
+               "given (PCRE_ERROR_BADNEWLINE)";
+    case PCRE_ERROR_BADOFFSET:
+        return "The value of startoffset was negative or greater than the length "
+               "of the subject, that is, the value in length (PCRE_ERROR_BADOFFSET)";
+    case PCRE_ERROR_SHORTUTF8:
+        return "This error is returned instead of PCRE_ERROR_BADUTF8 when the subject "
+               "string ends with a truncated UTF-8 character and the PCRE_PARTIAL_HARD option is set. "
+               "Information about the failure is returned as for PCRE_ERROR_BADUTF8. "
+               "It is in fact sufficient to detect this case, but this special error code for "
+               "PCRE_PARTIAL_HARD precedes the implementation of returned information; "
+               "it is retained for backwards compatibility (PCRE_ERROR_SHORTUTF8)";
+    case PCRE_ERROR_RECURSELOOP:
+        return "This error is returned when pcre_exec() detects a recursion loop "
+               "within the pattern. Specifically, it means that either the whole pattern "
+               "or a subpattern has been called recursively for the second time at the same "
+               "position in the subject string. Some simple patterns that might do this "
+               "are detected and faulted at compile time, but more complicated cases, "
+               "in particular mutual recursions between two different subpatterns, "
+               "cannot be detected until run time (PCRE_ERROR_RECURSELOOP)";
+    case PCRE_ERROR_JIT_STACKLIMIT:
+        return "This error is returned when a pattern that was successfully studied "
+               "using a JIT compile option is being matched, but the memory available "
+               "for the just-in-time processing stack is not large enough. See the pcrejit "
+               "documentation for more details (PCRE_ERROR_JIT_STACKLIMIT)";
+    case PCRE_ERROR_BADMODE:
+        return "This error is given if a pattern that was compiled by the 8-bit library "
+               "is passed to a 16-bit or 32-bit library function, or vice versa (PCRE_ERROR_BADMODE)";
+    case PCRE_ERROR_BADENDIANNESS:
+        return "This error is given if a pattern that was compiled and saved is reloaded on a "
+               "host with different endianness. The utility function pcre_pattern_to_host_byte_order() "
+               "can be used to convert such a pattern so that it runs on the new host (PCRE_ERROR_BADENDIANNESS)";
+    case PCRE_ERROR_DFA_BADRESTART:
+        return "PCRE_ERROR_DFA_BADRESTART";
+#if PCRE_MAJOR >= 8 && PCRE_MINOR >= 32
+    case PCRE_ERROR_BADLENGTH:
+        return "This error is given if pcre_exec() is called with a negative value for the length argument (PCRE_ERROR_BADLENGTH)";
+    case PCRE_ERROR_JIT_BADOPTION:
+        return "This error is returned when a pattern that was successfully studied using a JIT compile "
+               "option is being matched, but the matching mode (partial or complete match) does not correspond "
+               "to any JIT compilation mode. When the JIT fast path function is used, this error may be "
+               "also given for invalid options. See the pcrejit documentation for more details (PCRE_ERROR_JIT_BADOPTION)";
+#endif
+    }
+    return "";
+}
+
+struct RuleEngine::CompiledRule::Impl {
+    pcre *re{};
+    pcre_extra *extra{};
+};
+
+RuleEngine::CompiledRule::CompiledRule(Settings::Rule rule)
+    : rule(std::move(rule))
+    , mImpl(new Impl)
+{
+    const char *pcreCompileErrorStr = nullptr;
+    int erroffset = 0;
+    mImpl->re = pcre_compile(this->rule.pattern.c_str(),0,&pcreCompileErrorStr,&erroffset,nullptr);
+    if (!mImpl->re) {
+        errorId = "pcre_compile";
+        if (pcreCompileErrorStr)
+            errorMsg = "pcre_compile failed: " + std::string(pcreCompileErrorStr);
+        return;
+    }
+
+    // Optimize the regex, but only if PCRE_CONFIG_JIT is available
+#ifdef PCRE_CONFIG_JIT
+    const char *pcreStudyErrorStr = nullptr;
+    mImpl->extra = pcre_study(mImpl->re, PCRE_STUDY_JIT_COMPILE, &pcreStudyErrorStr);
+    // pcre_study() returns NULL for both errors and when it can not optimize the regex.
+    // The last argument is how one checks for errors.
+    // It is NULL if everything works, and points to an error string otherwise.
+    if (pcreStudyErrorStr) {
+        errorId = "pcre_study";
+        errorMsg = "pcre_study failed: " + std::string(pcreStudyErrorStr);
+        // pcre_compile() worked, but pcre_study() returned an error. Free the resources allocated by pcre_compile().
+        pcre_free(mImpl->re);
+        mImpl->re = nullptr;
+    }
+#endif
+}
+
+RuleEngine::CompiledRule::~CompiledRule()
+{
+    if (mImpl->re)
+        pcre_free(mImpl->re);
+#ifdef PCRE_CONFIG_JIT
+    // Free up the EXTRA PCRE value (may be NULL at this point)
+    if (mImpl->extra)
+        pcre_free_study(mImpl->extra);
+#endif
+}
+
+bool RuleEngine::CompiledRule::match(const std::string &str, std::size_t pos, std::size_t &pos1, std::size_t &pos2, std::string &error) const
+{
+    if (!mImpl->re || pos >= str.size())
+        return false;
+
+    int ovector[30]= {0};
+    const int pcreExecRet = pcre_exec(mImpl->re, mImpl->extra, str.c_str(), static_cast<int>(str.size()), static_cast<int>(pos), 0, ovector, 30);
+    if (pcreExecRet < 0) {
+        error = pcreErrorCodeToString(pcreExecRet);
+        return false;
+    }
+    pos1 = static_cast<unsigned int>(ovector[0]);
+    pos2 = static_cast<unsigned int>(ovector[1]);
+    return true;
+}
+
+RuleEngine::RuleEngine(const std::list<Settings::Rule> &rules)
+{
+    std::map<std::string, std::vector<std::string>> patterns;
+    for (const Settings::Rule &rule : rules) {
+        mRules.emplace_back(new CompiledRule(rule));
+        patterns[rule.tokenlist].push_back(rule.pattern);
+    }
+    for (const auto &p : patterns)
+        mPrefilters.emplace_back(p.first, RulePrefilter(p.second));
+}
+
+RuleEngine::~RuleEngine() = default;
+
+std::shared_ptr<const RuleEngine> RuleEngine::get(const std::list<Settings::Rule> &rules)
+{
+    static std::mutex sync;
+    static std::string cachedKey;
+    static std::shared_ptr<const RuleEngine> cached;
+
+    std::string key;
+    for (const Settings::Rule &rule : rules) {
+        key += rule.tokenlist + '\0' + rule.pattern + '\0' + rule.id + '\0' + rule.summary + '\0';
+        key += static_cast<char>(rule.severity);
+    }
+
+    std::lock_guard<std::mutex> l(sync);
+    if (!cached || key != cachedKey) {
+        cached = std::make_shared<const RuleEngine>(rules);
+        cachedKey = std::move(key);
+    }
+    return cached;
+}
+
+bool RuleEngine::hasRule(const std::string &tokenlist) const
+{
+    return std::any_of(mRules.cbegin(), mRules.cend(), [&](const std::unique_ptr<CompiledRule>& rule) {
+        return rule->rule.tokenlist == tokenlist;
+    });
+}
+
+std::vector<const RuleEngine::CompiledRule *> RuleEngine::getRules(const std::string &tokenlist) const
+{
+    std::vector<const CompiledRule *> ret;
+    for (const std::unique_ptr<CompiledRule> &rule : mRules) {
+        if (rule->rule.tokenlist == tokenlist)
+            ret.push_back(rule.get());
+    }
+    return ret;
+}
+
+std::vector<bool> RuleEngine::candidates(const std::string &tokenlist, const std::string &str) const
+{
+    const auto it = std::find_if(mPrefilters.cbegin(), mPrefilters.cend(), [&](const std::pair<std::string, RulePrefilter> &prefilter) {
+        return prefilter.first == tokenlist;
+    });
+    if (it == mPrefilters.cend())
+        return {};
+    return it->second.candidates(str);
+}
+#endif
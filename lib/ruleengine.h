@@ -0,0 +1,129 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef ruleengineH
+#define ruleengineH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#ifdef HAVE_RULES
+#include "settings.h"
+#endif
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Prefilter for the regular expressions of the rules.
+ *
+ * Every match of a regular expression contains the literal strings that are required by the
+ * expression. The literals of all expressions are searched in a single scan of the code, an
+ * expression only needs to be executed if all of its literals are found.
+ */
+class CPPCHECKLIB RulePrefilter {
+public:
+    explicit RulePrefilter(const std::vector<std::string> &patterns);
+
+    /**
+     * @return the literal strings that every match of the regular expression contains. Only
+     * the simple parts of the expression are analyzed, the result is empty when nothing is known.
+     */
+    static std::vector<std::string> requiredLiterals(const std::string &pattern);
+
+    /** @return for each pattern whether it might match the string */
+    std::vector<bool> candidates(const std::string &str) const;
+
+private:
+    /** the literals that are required by each pattern */
+    std::vector<std::vector<std::size_t>> mPatternLiterals;
+    std::size_t mLiteralCount{};
+    /** transitions of the Aho-Corasick automaton, 256 per state */
+    std::vector<int> mTransitions;
+    /** the literals that end in each state */
+    std::vector<std::vector<std::size_t>> mOutputs;
+};
+
+#ifdef HAVE_RULES
+/**
+ * @brief The compiled regular expressions of the rules.
+ *
+ * The rules are compiled once per analysis and shared by all threads.
+ */
+class CPPCHECKLIB RuleEngine {
+public:
+    explicit RuleEngine(const std::list<Settings::Rule> &rules);
+    ~RuleEngine();
+
+    RuleEngine(const RuleEngine &) = delete;
+    RuleEngine &operator=(const RuleEngine &) = delete;
+
+    /** @return the compiled rules, these are reused as long as the rules do not change */
+    static std::shared_ptr<const RuleEngine> get(const std::list<Settings::Rule> &rules);
+
+    class CPPCHECKLIB CompiledRule {
+    public:
+        explicit CompiledRule(Settings::Rule rule);
+        ~CompiledRule();
+
+        CompiledRule(const CompiledRule &) = delete;
+        CompiledRule &operator=(const CompiledRule &) = delete;
+
+        /**
+         * Find the next match in the string.
+         * @return false if there is no match or the matching failed, in that case error is set
+         */
+        bool match(const std::string &str, std::size_t pos, std::size_t &pos1, std::size_t &pos2, std::string &error) const;
+
+        const Settings::Rule rule;
+        /** id of the error when the rule could not be compiled */
+        std::string errorId;
+        std::string errorMsg;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> mImpl;
+    };
+
+    /** @return true if there are rules for the token list (define / normal / raw) */
+    bool hasRule(const std::string &tokenlist) const;
+
+    /** @return the rules for the token list in the given order */
+    std::vector<const CompiledRule *> getRules(const std::string &tokenlist) const;
+
+    /** @return for each rule of the token list whether it might match the string */
+    std::vector<bool> candidates(const std::string &tokenlist, const std::string &str) const;
+
+private:
+    std::vector<std::unique_ptr<CompiledRule>> mRules;
+    /** the prefilter of the rules of each token list */
+    std::vector<std::pair<std::string, RulePrefilter>> mPrefilters;
+};
+#endif
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // ruleengineH
@@ -123,9 +123,16 @@ public:
     /** @brief Path to the python interpreter to be used to run addons. */
     std::string addonPython;
 
+    /** @brief Run the python addons in long-lived worker processes instead of one process per file (--addon-server). */
+    bool addonServer{};
+
     /** @brief Analyze all configuration in Visual Studio project. */
     bool analyzeAllVsConfigs{true};
 
+    enum class AnalyzerInfoFormat : std::uint8_t { binary, xml };
+    /** @brief Format of the analyzer information in the build dir (--analyzer-info-format) */
+    AnalyzerInfoFormat analyzerInfoFormat = AnalyzerInfoFormat::binary;
+
     /** @brief Paths used as base for conversion to relative paths. */
     std::vector<std::string> basePaths;
 
@@ -149,6 +156,10 @@ public:
     /** @brief The maximum time in seconds for the checks of a single file */
     int checksMaxTime{};
 
+    /** @brief The maximum time in seconds of a check for a single file, the key is the name of the check.
+        The check is skipped for the remaining configurations of the file when the time is exceeded. */
+    std::map<std::string, int> checkMaxTime;
+
     /** @brief --checkers-report=<filename> : Generate report of executed checkers */
     std::string checkersReportFilename;
 
@@ -176,6 +187,10 @@ public:
     /** @brief include paths excluded from checking the configuration */
     std::set<std::string> configExcludePaths;
 
+    /** @brief How many configurations of a single file should be simplified
+        at the same time. Default is 1. (--config-jobs=N) */
+    unsigned int configJobs = 1;
+
     /** cppcheck.cfg: Custom product name */
     std::string cppcheckCfgProductName;
 
@@ -233,6 +248,10 @@ public:
     /** @brief Is --dump given? */
     bool dump{};
 
+    enum class DumpFormat : std::uint8_t { xml, binary };
+    /** @brief Format of the dump files that are written for --dump and the addons (--dump-format) */
+    DumpFormat dumpFormat = DumpFormat::xml;
+
     /** @brief Do not filter duplicated errors. */
     bool emitDuplicates{};
 
@@ -326,6 +345,9 @@ public:
     /** @brief Using -E for debugging purposes */
     bool preprocessOnly{};
 
+    /** @brief Fork the children of --executor=process once and assign the files to them (--process-pool) */
+    bool processPool{};
+
     /** @brief Is --quiet given? */
     bool quiet{};
 
@@ -407,9 +429,15 @@ public:
     SimpleEnableGroup<Certainty> certainty;
     SimpleEnableGroup<Checks> checks;
 
+    /** @brief --report-slow-checks=<n> : report the n slowest checks of the analyzed files */
+    int reportSlowChecks{};
+
     /** @brief show timing information (--showtime=file|summary|top5) */
     SHOWTIME_MODES showtime{};
 
+    /** @brief --showtime-trace=<filename> : write the timer scopes to a trace event file */
+    std::string showtimeTraceFile;
+
     /** Struct contains standards settings */
     Standards standards;
 
@@ -468,6 +496,9 @@ public:
 
         /** @brief Maximum expression varid depth */
         int maxExprVarIdDepth = 4;
+
+        /** @brief Experimental: number of threads that analyze independent function scopes */
+        unsigned int jobs = 1;
     };
 
     /** @brief The ValueFlow options */
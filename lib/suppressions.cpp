@@ -32,7 +32,9 @@
 #include <cstring>
 #include <functional> // std::bind, std::placeholders
 #include <sstream>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "xml.h"
 
@@ -288,6 +290,7 @@ std::string SuppressionList::addSuppression(SuppressionList::Suppression suppres
         return "Failed to add suppression. Invalid glob pattern '" + suppression.fileName + "'.";
 
     mSuppressions.push_back(std::move(suppression));
+    mIndexed.clear();
 
     return "";
 }
@@ -459,13 +462,114 @@ std::string SuppressionList::Suppression::getText() const
     return ret;
 }
 
+// matchglob() does not distinguish the path separators
+static std::string unifyPathSeparators(std::string path)
+{
+    std::replace(path.begin(), path.end(), '\\', '/');
+    return path;
+}
+
+void SuppressionList::FileIndex::add(std::size_t index, const Suppression &suppression)
+{
+    if (suppression.type == SuppressionList::Type::unique && suppression.lineNumber != Suppression::NO_LINE)
+        lines[suppression.lineNumber].push_back(index);
+    else if (!suppression.errorId.empty() && suppression.errorId.find_first_of("?*") == std::string::npos)
+        ids[suppression.errorId].push_back(index);
+    else
+        patterns.push_back(index);
+}
+
+void SuppressionList::updateIndex()
+{
+    if (!mIndexed.empty() || mSuppressions.empty())
+        return;
+
+    mFileIndex.clear();
+    mAnyFileIndex = FileIndex();
+    mFilePatternIndex.clear();
+    mFilePatternPrefixLengths.clear();
+    mMacroIndex.clear();
+
+    for (Suppression &s : mSuppressions) {
+        const std::size_t index = mIndexed.size();
+        mIndexed.push_back(&s);
+        if (s.type == SuppressionList::Type::macro) {
+            mMacroIndex[s.macroName].push_back(index);
+        } else if (s.fileName.empty()) {
+            mAnyFileIndex.add(index, s);
+        } else if (s.isWildcard()) {
+            std::string prefix = unifyPathSeparators(s.fileName.substr(0, s.fileName.find_first_of("?*")));
+            mFilePatternPrefixLengths.insert(prefix.size());
+            mFilePatternIndex[std::move(prefix)].push_back(index);
+        } else {
+            mFileIndex[unifyPathSeparators(s.fileName)].add(index, s);
+        }
+    }
+}
+
+void SuppressionList::addCandidates(FileIndex &index, const SuppressionList::ErrorMessage &errmsg, bool markChecked, std::vector<std::size_t> &candidates) const
+{
+    // the previous line is needed for the suppressions that also apply to the next line
+    for (const int line : { errmsg.lineNumber, errmsg.lineNumber - 1 }) {
+        const auto it = index.lines.find(line);
+        if (it != index.lines.end())
+            candidates.insert(candidates.end(), it->second.cbegin(), it->second.cend());
+    }
+
+    const auto it = index.ids.find(errmsg.errorId);
+    if (it != index.ids.end())
+        candidates.insert(candidates.end(), it->second.cbegin(), it->second.cend());
+    candidates.insert(candidates.end(), index.patterns.cbegin(), index.patterns.cend());
+
+    // the suppressions with another error id are checked by every message
+    if (markChecked && !index.checked) {
+        for (const auto& ids : index.ids) {
+            for (const std::size_t i : ids.second)
+                mIndexed[i]->checked = true;
+        }
+        index.checked = true;
+    }
+}
+
+std::vector<std::size_t> SuppressionList::getCandidates(const SuppressionList::ErrorMessage &errmsg, bool global, bool markChecked)
+{
+    updateIndex();
+
+    std::vector<std::size_t> candidates;
+    const std::string fileName = unifyPathSeparators(errmsg.getFileName());
+
+    const auto it = mFileIndex.find(fileName);
+    if (it != mFileIndex.end())
+        addCandidates(it->second, errmsg, markChecked, candidates);
+
+    if (global) {
+        addCandidates(mAnyFileIndex, errmsg, markChecked, candidates);
+        for (const std::size_t len : mFilePatternPrefixLengths) {
+            if (len > fileName.size())
+                break;
+            const auto it2 = mFilePatternIndex.find(fileName.substr(0, len));
+            if (it2 != mFilePatternIndex.end())
+                candidates.insert(candidates.end(), it2->second.cbegin(), it2->second.cend());
+        }
+    }
+
+    for (const std::string &macroName : errmsg.macroNames) {
+        const auto it2 = mMacroIndex.find(macroName);
+        if (it2 != mMacroIndex.end())
+            candidates.insert(candidates.end(), it2->second.cbegin(), it2->second.cend());
+    }
+
+    return candidates;
+}
+
 bool SuppressionList::isSuppressed(const SuppressionList::ErrorMessage &errmsg, bool global)
 {
     std::lock_guard<std::mutex> lg(mSuppressionsSync);
 
     const bool unmatchedSuppression(errmsg.errorId == "unmatchedSuppression");
     bool returnValue = false;
-    for (Suppression &s : mSuppressions) {
+    for (const std::size_t i : getCandidates(errmsg, global, !unmatchedSuppression)) {
+        Suppression &s = *mIndexed[i];
         if (!global && !s.isLocal())
             continue;
         if (unmatchedSuppression && s.errorId != errmsg.errorId)
@@ -480,7 +584,11 @@ bool SuppressionList::isSuppressedExplicitly(const SuppressionList::ErrorMessage
 {
     std::lock_guard<std::mutex> lg(mSuppressionsSync);
 
-    for (Suppression &s : mSuppressions) {
+    // the first matching suppression in list order is marked as matched
+    std::vector<std::size_t> candidates = getCandidates(errmsg, global, false);
+    std::sort(candidates.begin(), candidates.end());
+    for (const std::size_t i : candidates) {
+        Suppression &s = *mIndexed[i];
         if (!global && !s.isLocal())
             continue;
         if (s.errorId != errmsg.errorId) // Error id must match exactly
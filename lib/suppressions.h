@@ -29,6 +29,7 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -290,9 +291,46 @@ public:
     static bool reportUnmatchedSuppressions(const std::list<SuppressionList::Suppression> &unmatched, ErrorLogger &errorLogger);
 
 private:
+    /** @brief Suppressions of a file (or of all files), the values are indexes into mIndexed */
+    struct FileIndex {
+        void add(std::size_t index, const Suppression &suppression);
+
+        /** @brief suppressions of a single line by line number */
+        std::unordered_map<int, std::vector<std::size_t>> lines;
+        /** @brief suppressions with an exact error id by error id */
+        std::unordered_map<std::string, std::vector<std::size_t>> ids;
+        /** @brief suppressions with an error id pattern or without error id */
+        std::vector<std::size_t> patterns;
+        /** @brief all suppressions in ids have been marked as checked */
+        bool checked{};
+    };
+
+    void updateIndex();
+
+    /**
+     * @brief Returns the suppressions that might match the message. The suppressions that apply
+     * to the message but can not match the error id are marked as checked if markChecked is set.
+     */
+    std::vector<std::size_t> getCandidates(const ErrorMessage &errmsg, bool global, bool markChecked);
+
+    void addCandidates(FileIndex &index, const ErrorMessage &errmsg, bool markChecked, std::vector<std::size_t> &candidates) const;
+
     mutable std::mutex mSuppressionsSync;
     /** @brief List of error which the user doesn't want to see. */
     std::list<Suppression> mSuppressions;
+
+    /** @brief The suppressions in list order, the index needs to be updated when this is empty */
+    std::vector<Suppression*> mIndexed;
+    /** @brief Suppressions with a file name without wildcards by file name */
+    std::unordered_map<std::string, FileIndex> mFileIndex;
+    /** @brief Suppressions without file name */
+    FileIndex mAnyFileIndex;
+    /** @brief Suppressions with a file name pattern by the text before the first wildcard */
+    std::unordered_map<std::string, std::vector<std::size_t>> mFilePatternIndex;
+    /** @brief Lengths of the keys in mFilePatternIndex */
+    std::set<std::size_t> mFilePatternPrefixLengths;
+    /** @brief Macro suppressions by macro name */
+    std::unordered_map<std::string, std::vector<std::size_t>> mMacroIndex;
 };
 
 struct Suppressions
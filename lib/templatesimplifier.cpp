@@ -23,6 +23,7 @@
 #include "mathlib.h"
 #include "settings.h"
 #include "standards.h"
+#include "timer.h"
 #include "token.h"
 #include "tokenize.h"
 #include "tokenlist.h"
@@ -31,6 +32,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <stack>
@@ -74,16 +76,6 @@ namespace {
         const Token * const mToken;
     };
 
-    class FindName {
-    public:
-        explicit FindName(std::string name) : mName(std::move(name)) {}
-        bool operator()(const TemplateSimplifier::TokenAndName &tokenAndName) const {
-            return tokenAndName.name() == mName;
-        }
-    private:
-        const std::string mName;
-    };
-
     class FindFullName {
     public:
         explicit FindFullName(std::string fullName) : mFullName(std::move(fullName)) {}
@@ -713,15 +705,63 @@ void TemplateSimplifier::addInstantiation(Token *token, const std::string &scope
 {
     simplifyTemplateArgs(token->tokAt(2), token->next()->findClosingBracket());
 
-    TokenAndName instantiation(token, scope);
+    const TokenAndName instantiation(token, scope);
 
     // check if instantiation already exists before adding it
-    const auto it = std::find(mTemplateInstantiations.cbegin(),
-                              mTemplateInstantiations.cend(),
-                              instantiation);
+    const auto bucket = mTemplateInstantiationsByName.find(instantiation.name());
+    if (bucket != mTemplateInstantiationsByName.cend() &&
+        std::any_of(bucket->second.cbegin(), bucket->second.cend(), [&](const std::list<TokenAndName>::iterator &it) {
+        return *it == instantiation;
+    }))
+        return;
+
+    insertInstantiation(token, scope);
+}
+
+void TemplateSimplifier::insertInstantiation(Token *token, const std::string &scope)
+{
+    mTemplateInstantiations.emplace_back(token, scope);
+    mTemplateInstantiationsByName[mTemplateInstantiations.back().name()].push_back(std::prev(mTemplateInstantiations.end()));
+}
+
+std::list<TemplateSimplifier::TokenAndName>::iterator TemplateSimplifier::eraseInstantiation(std::list<TokenAndName>::const_iterator it)
+{
+    const auto bucket = mTemplateInstantiationsByName.find(it->name());
+    if (bucket != mTemplateInstantiationsByName.end()) {
+        bucket->second.remove_if([&](const std::list<TokenAndName>::iterator &inst) {
+            return &*inst == &*it;
+        });
+    }
+    return mTemplateInstantiations.erase(it);
+}
+
+std::list<TemplateSimplifier::TokenAndName>::iterator TemplateSimplifier::findInstantiation(const Token *tok)
+{
+    const std::set<TokenAndName*>* pointers = tok->templateSimplifierPointers();
+    if (!pointers)
+        return mTemplateInstantiations.end();
+
+    // the instantiations of the token are found through the names of its pointers
+    std::set<std::string> names;
+    for (const TokenAndName *tokenAndName : *pointers)
+        names.insert(tokenAndName->name());
+    for (const std::string &name : names) {
+        const auto bucket = mTemplateInstantiationsByName.find(name);
+        if (bucket == mTemplateInstantiationsByName.end())
+            continue;
+        const auto it = std::find_if(bucket->second.cbegin(), bucket->second.cend(), [&](const std::list<TokenAndName>::iterator &inst) {
+            return inst->token() == tok;
+        });
+        if (it != bucket->second.cend())
+            return *it;
+    }
+    return mTemplateInstantiations.end();
+}
 
-    if (it == mTemplateInstantiations.cend())
-        mTemplateInstantiations.emplace_back(std::move(instantiation));
+void TemplateSimplifier::clearInstantiations()
+{
+    mTemplateInstantiations.clear();
+    mTemplateInstantiationsByName.clear();
 }
 
 static const Token* getFunctionToken(const Token* nameToken)
@@ -1131,8 +1171,9 @@ void TemplateSimplifier::useDefaultArgumentValues(TokenAndName &declaration)
     if (eq.empty())
         return;
 
-    // iterate through all template instantiations
-    for (const TokenAndName &instantiation : mTemplateInstantiations) {
+    // iterate through the template instantiations with the same name
+    for (const std::list<TokenAndName>::iterator &instantiationIt : mTemplateInstantiationsByName[declaration.name()]) {
+        const TokenAndName &instantiation = *instantiationIt;
         if (declaration.fullName() != instantiation.fullName())
             continue;
 
@@ -1247,11 +1288,9 @@ void TemplateSimplifier::useDefaultArgumentValues(TokenAndName &declaration)
             if (Token::Match(tok2, "(|{|["))
                 tok2 = tok2->link();
             else if (Token::Match(tok2, "%type% <") && (tok2->strAt(2) == ">" || templateParameters(tok2->next()))) {
-                const auto ti = std::find_if(mTemplateInstantiations.cbegin(),
-                                             mTemplateInstantiations.cend(),
-                                             FindToken(tok2));
+                const auto ti = findInstantiation(tok2);
                 if (ti != mTemplateInstantiations.end())
-                    mTemplateInstantiations.erase(ti);
+                    eraseInstantiation(ti);
                 ++indentlevel;
             } else if (indentlevel > 0 && tok2->str() == ">")
                 --indentlevel;
@@ -1266,11 +1305,9 @@ void TemplateSimplifier::useDefaultArgumentValues(TokenAndName &declaration)
             continue;
 
         // don't strip args from uninstantiated templates
-        const auto ti2 = std::find_if(mTemplateInstantiations.cbegin(),
-                                      mTemplateInstantiations.cend(),
-                                      FindName(declaration.name()));
+        const auto ti2 = mTemplateInstantiationsByName.find(declaration.name());
 
-        if (ti2 == mTemplateInstantiations.end())
+        if (ti2 == mTemplateInstantiationsByName.end() || ti2->second.empty())
             continue;
 
         eraseTokens(eqtok, tok2);
@@ -1372,10 +1409,8 @@ void TemplateSimplifier::simplifyTemplateAliases()
                 if (aliasParameterNames.find(tok2->str()) == aliasParameterNames.end()) {
                     // Create template instance..
                     if (Token::Match(tok1, "%name% <")) {
-                        const auto it = std::find_if(mTemplateInstantiations.cbegin(),
-                                                     mTemplateInstantiations.cend(),
-                                                     FindToken(tok1));
-                        if (it != mTemplateInstantiations.cend())
+                        const auto it = findInstantiation(tok1);
+                        if (it != mTemplateInstantiations.end())
                             addInstantiation(tok2, it->scope());
                     }
                 }
@@ -1386,7 +1421,7 @@ void TemplateSimplifier::simplifyTemplateAliases()
             found = true;
 
             // erase this instantiation
-            it2 = mTemplateInstantiations.erase(it2);
+            it2 = eraseInstantiation(it2);
         }
 
         if (found) {
@@ -2308,7 +2343,7 @@ void TemplateSimplifier::expandTemplate(
         // only add recursive instantiation if its arguments are a constant expression
         if (templateDeclaration.name() != inst.token->str() ||
             (inst.token->tokAt(2)->isNumber() || inst.token->tokAt(2)->isStandardType()))
-            mTemplateInstantiations.emplace_back(inst.token, inst.scope);
+            insertInstantiation(inst.token, inst.scope);
     }
 }
 
@@ -3097,7 +3132,11 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
 
     bool instantiated = false;
 
-    for (const TokenAndName &instantiation : mTemplateInstantiations) {
+    // only the instantiations with the same name can match the declaration
+    const std::list<std::list<TokenAndName>::iterator> &instantiations = mTemplateInstantiationsByName[templateDeclaration.name()];
+
+    for (const std::list<TokenAndName>::iterator &instantiationIt : instantiations) {
+        const TokenAndName &instantiation = *instantiationIt;
         // skip deleted instantiations
         if (!instantiation.token())
             continue;
@@ -3420,13 +3459,9 @@ void TemplateSimplifier::replaceTemplateUsage(
         // Foo < int >  =>  Foo<int>
         for (const Token *tok = nameTok1->next(); tok != tok2; tok = tok->next()) {
             if (tok->isName() && tok->templateSimplifierPointers() && !tok->templateSimplifierPointers()->empty()) {
-                for (auto ti = mTemplateInstantiations.cbegin(); ti != mTemplateInstantiations.cend();) {
-                    if (ti->token() == tok) {
-                        mTemplateInstantiations.erase(ti);
-                        break;
-                    }
-                    ++ti;
-                }
+                const auto ti = findInstantiation(tok);
+                if (ti != mTemplateInstantiations.end())
+                    eraseInstantiation(ti);
             }
         }
         // Fix crash in #9007
@@ -3819,13 +3854,15 @@ void TemplateSimplifier::simplifyTemplates(const std::time_t maxtime)
             mTemplateForwardDeclarationsMap.clear();
             mTemplateSpecializationMap.clear();
             mTemplatePartialSpecializationMap.clear();
-            mTemplateInstantiations.clear();
+            clearInstantiations();
             mInstantiatedTemplates.clear();
             mExplicitInstantiationsToDelete.clear();
             mTemplateNamePos.clear();
         }
 
-        getTemplateDeclarations();
+        Timer::run("TemplateSimplifier::getTemplateDeclarations", mSettings.showtime, mTokenizer.mTimerResults, [&]() {
+            getTemplateDeclarations();
+        });
 
         if (passCount == 0) {
             mDump.clear();
@@ -3856,12 +3893,18 @@ void TemplateSimplifier::simplifyTemplates(const std::time_t maxtime)
         getPartialSpecializations();
 
         // Locate possible instantiations of templates..
-        getTemplateInstantiations();
+        Timer::run("TemplateSimplifier::getTemplateInstantiations", mSettings.showtime, mTokenizer.mTimerResults, [&]() {
+            getTemplateInstantiations();
+        });
 
         // Template arguments with default values
-        useDefaultArgumentValues();
+        Timer::run("TemplateSimplifier::useDefaultArgumentValues", mSettings.showtime, mTokenizer.mTimerResults, [&]() {
+            useDefaultArgumentValues();
+        });
 
-        simplifyTemplateAliases();
+        Timer::run("TemplateSimplifier::simplifyTemplateAliases", mSettings.showtime, mTokenizer.mTimerResults, [&]() {
+            simplifyTemplateAliases();
+        });
 
         if (mSettings.debugtemplate)
             printOut("### Template Simplifier pass " + std::to_string(passCount + 1) + " ###");
@@ -3919,28 +3962,28 @@ void TemplateSimplifier::simplifyTemplates(const std::time_t maxtime)
 
         std::set<std::string> expandedtemplates;
 
-        for (auto iter1 = mTemplateDeclarations.crbegin(); iter1 != mTemplateDeclarations.crend(); ++iter1) {
-            if (iter1->isAlias() || iter1->isFriend())
-                continue;
+        // get specializations..
+        std::unordered_map<std::string, std::list<const Token *>> specializations;
+        for (const TokenAndName &decl : mTemplateDeclarations) {
+            if (!decl.isAlias() && !decl.isFriend())
+                specializations[decl.fullName()].push_back(decl.nameToken());
+        }
 
-            // get specializations..
-            std::list<const Token *> specializations;
-            for (auto iter2 = mTemplateDeclarations.cbegin(); iter2 != mTemplateDeclarations.cend(); ++iter2) {
-                if (iter2->isAlias() || iter2->isFriend())
+        {
+            Timer t("TemplateSimplifier::simplifyTemplateInstantiations", mSettings.showtime, mTokenizer.mTimerResults);
+            for (auto iter1 = mTemplateDeclarations.crbegin(); iter1 != mTemplateDeclarations.crend(); ++iter1) {
+                if (iter1->isAlias() || iter1->isFriend())
                     continue;
 
-                if (iter1->fullName() == iter2->fullName())
-                    specializations.push_back(iter2->nameToken());
-            }
-
-            const bool instantiated = simplifyTemplateInstantiations(
-                *iter1,
-                specializations,
-                maxtime,
-                expandedtemplates);
-            if (instantiated) {
-                mInstantiatedTemplates.push_back(*iter1);
-                mTemplateNamePos.clear(); // positions might be invalid after instantiations
+                const bool instantiated = simplifyTemplateInstantiations(
+                    *iter1,
+                    specializations[iter1->fullName()],
+                    maxtime,
+                    expandedtemplates);
+                if (instantiated) {
+                    mInstantiatedTemplates.push_back(*iter1);
+                    mTemplateNamePos.clear(); // positions might be invalid after instantiations
+                }
             }
         }
 
@@ -345,6 +345,25 @@ private:
      */
     void addInstantiation(Token *token, const std::string &scope);
 
+    /** Append a template instantiation to mTemplateInstantiations and index it by name.
+     * @param token first token of instantiation
+     * @param scope scope of instantiation
+     */
+    void insertInstantiation(Token *token, const std::string &scope);
+
+    /** Erase a template instantiation and remove it from the name index.
+     * @return iterator to the following instantiation
+     */
+    std::list<TokenAndName>::iterator eraseInstantiation(std::list<TokenAndName>::const_iterator it);
+
+    /** Find the template instantiation of a token.
+     * @return iterator to the instantiation or mTemplateInstantiations.end()
+     */
+    std::list<TokenAndName>::iterator findInstantiation(const Token *tok);
+
+    /** Clear the template instantiations and the name index */
+    void clearInstantiations();
+
     /**
      * Get template instantiations
      */
@@ -504,6 +523,8 @@ private:
     std::map<Token *, Token *> mTemplateSpecializationMap;
     std::map<Token *, Token *> mTemplatePartialSpecializationMap;
     std::list<TokenAndName> mTemplateInstantiations;
+    /** mTemplateInstantiations indexed by name. The instantiations of each name are in the order of mTemplateInstantiations. */
+    std::unordered_map<std::string, std::list<std::list<TokenAndName>::iterator>> mTemplateInstantiationsByName;
     std::list<TokenAndName> mInstantiatedTemplates;
     std::list<TokenAndName> mMemberFunctionsToDelete;
     std::vector<TokenAndName> mExplicitInstantiationsToDelete;
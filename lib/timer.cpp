@@ -18,13 +18,21 @@
 
 #include "timer.h"
 
+#include "json.h"
 #include "utils.h"
 
 #include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <fstream>
 #include <iostream>
 #include <utility>
 #include <vector>
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 namespace {
     using dataElementType = std::pair<std::string, TimerResultsData>;
     bool more_second_sec(const dataElementType& lhs, const dataElementType& rhs)
@@ -34,6 +42,39 @@ namespace {
 
     // TODO: remove and print through (synchronized) ErrorLogger instead
     std::mutex stdCoutLock;
+
+    struct TraceEvent {
+        std::string name;
+        int tid;
+        std::chrono::steady_clock::duration start;
+        std::chrono::nanoseconds wall;
+        std::chrono::nanoseconds cpu;
+    };
+
+    struct TraceData {
+        std::atomic<bool> enabled{};
+        std::mutex sync;
+        std::chrono::steady_clock::time_point origin;
+        std::vector<TraceEvent> events;
+        std::atomic<int> threads{};
+    };
+
+    TraceData& traceData()
+    {
+        static TraceData data;
+        return data;
+    }
+
+    int traceThreadId()
+    {
+        static thread_local const int tid = ++traceData().threads;
+        return tid;
+    }
+
+    double microseconds(std::chrono::nanoseconds d)
+    {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
 }
 
 // TODO: this does not include any file context when SHOWTIME_FILE thus rendering it useless - should we include the logging with the progress logging?
@@ -45,12 +86,15 @@ void TimerResults::showResults(SHOWTIME_MODES mode) const
 
     TimerResultsData overallData;
     std::vector<dataElementType> data;
+    std::map<std::string, std::size_t> counts;
 
     {
         std::lock_guard<std::mutex> l(mResultsSync);
 
         data.reserve(mResults.size());
         data.insert(data.begin(), mResults.cbegin(), mResults.cend());
+        if (mode != SHOWTIME_MODES::SHOWTIME_TOP5_FILE && mode != SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY)
+            counts = mCounts;
     }
     std::sort(data.begin(), data.end(), more_second_sec);
 
@@ -76,67 +120,241 @@ void TimerResults::showResults(SHOWTIME_MODES mode) const
                     return d.first.size() == pos && iter->first.compare(0, d.first.size(), d.first) == 0;
                 });
         }
-        if (!hasParent)
-            overallData.mClocks += iter->second.mClocks;
+        if (!hasParent) {
+            overallData.mWall += iter->second.mWall;
+            overallData.mCpu += iter->second.mCpu;
+        }
         if ((mode != SHOWTIME_MODES::SHOWTIME_TOP5_FILE && mode != SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY) || (ordinal<=5)) {
-            std::cout << iter->first << ": " << sec << "s (avg. " << secAverage << "s - " << iter->second.mNumberOfResults  << " result(s))" << std::endl;
+            std::cout << iter->first << ": " << sec << "s (cpu: " << iter->second.cpuSeconds() << "s, avg. " << secAverage << "s - " << iter->second.mNumberOfResults  << " result(s))" << std::endl;
         }
         ++ordinal;
     }
 
     const double secOverall = overallData.seconds();
-    std::cout << "Overall time: " << secOverall << "s" << std::endl;
+    std::cout << "Overall time: " << secOverall << "s (cpu: " << overallData.cpuSeconds() << "s)" << std::endl;
+
+    for (const auto& count : counts)
+        std::cout << count.first << ": " << count.second << std::endl;
+}
+
+void TimerResults::addResults(const std::string& str, std::chrono::nanoseconds wall, std::chrono::nanoseconds cpu)
+{
+    std::lock_guard<std::mutex> l(mResultsSync);
+
+    TimerResultsData& data = mResults[str];
+    data.mWall += wall;
+    data.mCpu += cpu;
+    data.mNumberOfResults++;
 }
 
-void TimerResults::addResults(const std::string& str, std::clock_t clocks)
+void TimerResults::addCount(const std::string& str, std::size_t count)
 {
     std::lock_guard<std::mutex> l(mResultsSync);
 
-    mResults[str].mClocks += clocks;
-    mResults[str].mNumberOfResults++;
+    mCounts[str] += count;
 }
 
 void TimerResults::reset()
+{
+    std::lock_guard<std::mutex> l(mResultsSync);
+    mResults.clear();
+    mCounts.clear();
+}
+
+void TimerSlowest::add(std::string str, std::chrono::nanoseconds wall, std::size_t max)
+{
+    std::lock_guard<std::mutex> l(mResultsSync);
+
+    if (mResults.size() >= max && (max == 0 || mResults.back().second >= wall))
+        return;
+    const auto it = std::upper_bound(mResults.begin(), mResults.end(), wall, [](std::chrono::nanoseconds d, const std::pair<std::string, std::chrono::nanoseconds>& result) {
+        return d > result.second;
+    });
+    mResults.emplace(it, std::move(str), wall);
+    if (mResults.size() > max)
+        mResults.pop_back();
+}
+
+std::vector<std::pair<std::string, std::chrono::nanoseconds>> TimerSlowest::results() const
+{
+    std::lock_guard<std::mutex> l(mResultsSync);
+    return mResults;
+}
+
+void TimerSlowest::showResults(const std::string& title) const
+{
+    const std::vector<std::pair<std::string, std::chrono::nanoseconds>> data = results();
+    if (data.empty())
+        return;
+
+    std::lock_guard<std::mutex> l(stdCoutLock);
+
+    std::cout << std::endl << title << ":" << std::endl;
+    for (const auto& result : data)
+        std::cout << result.first << ": " << std::chrono::duration<double>(result.second).count() << "s" << std::endl;
+}
+
+void TimerSlowest::reset()
 {
     std::lock_guard<std::mutex> l(mResultsSync);
     mResults.clear();
 }
 
+void TimerTrace::start()
+{
+    TraceData& data = traceData();
+    std::lock_guard<std::mutex> l(data.sync);
+    data.events.clear();
+    data.origin = std::chrono::steady_clock::now();
+    data.enabled = true;
+}
+
+void TimerTrace::reset()
+{
+    TraceData& data = traceData();
+    std::lock_guard<std::mutex> l(data.sync);
+    data.enabled = false;
+    data.events.clear();
+}
+
+bool TimerTrace::enabled()
+{
+    return traceData().enabled;
+}
+
+void TimerTrace::add(const std::string& name, std::chrono::steady_clock::time_point start, std::chrono::nanoseconds wall, std::chrono::nanoseconds cpu)
+{
+    TraceData& data = traceData();
+    const int tid = traceThreadId();
+    std::lock_guard<std::mutex> l(data.sync);
+    if (!data.enabled)
+        return;
+    data.events.push_back({name, tid, start - data.origin, wall, cpu});
+}
+
+std::string TimerTrace::toJson()
+{
+    TraceData& data = traceData();
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> l(data.sync);
+        events = data.events;
+    }
+
+    // the viewers expect the enclosing scopes first when scopes start at the same time
+    std::stable_sort(events.begin(), events.end(), [](const TraceEvent& lhs, const TraceEvent& rhs) {
+        if (lhs.tid != rhs.tid)
+            return lhs.tid < rhs.tid;
+        if (lhs.start != rhs.start)
+            return lhs.start < rhs.start;
+        return lhs.wall > rhs.wall;
+    });
+
+    picojson::array traceEvents;
+    traceEvents.reserve(events.size());
+    for (const TraceEvent& event : events) {
+        picojson::object args;
+        args["cpu"] = picojson::value(microseconds(event.cpu));
+
+        picojson::object obj;
+        obj["name"] = picojson::value(event.name);
+        obj["ph"] = picojson::value("X");
+        obj["pid"] = picojson::value(1.0);
+        obj["tid"] = picojson::value(static_cast<double>(event.tid));
+        obj["ts"] = picojson::value(microseconds(std::chrono::duration_cast<std::chrono::nanoseconds>(event.start)));
+        obj["dur"] = picojson::value(microseconds(event.wall));
+        obj["args"] = picojson::value(std::move(args));
+        traceEvents.emplace_back(std::move(obj));
+    }
+
+    picojson::object trace;
+    trace["traceEvents"] = picojson::value(std::move(traceEvents));
+    trace["displayTimeUnit"] = picojson::value("ms");
+    return picojson::value(std::move(trace)).serialize();
+}
+
+bool TimerTrace::write(const std::string& filename)
+{
+    std::ofstream fout(filename);
+    if (!fout.is_open())
+        return false;
+    fout << toJson() << std::endl;
+    return fout.good();
+}
+
+std::chrono::nanoseconds Timer::threadCpuTime()
+{
+#if defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        const auto ticks = [](const FILETIME& t) {
+            return (static_cast<unsigned long long>(t.dwHighDateTime) << 32) | t.dwLowDateTime;
+        };
+        // FILETIME counts 100 nanosecond intervals
+        return std::chrono::nanoseconds((ticks(kernelTime) + ticks(userTime)) * 100);
+    }
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+#endif
+    // the CPU time of the process
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(static_cast<double>(std::clock()) / CLOCKS_PER_SEC));
+}
+
 Timer::Timer(std::string str, SHOWTIME_MODES showtimeMode, TimerResultsIntf* timerResults)
     : mStr(std::move(str))
     , mTimerResults(timerResults)
-    , mStart(std::clock())
     , mShowTimeMode(showtimeMode)
-    , mStopped(showtimeMode == SHOWTIME_MODES::SHOWTIME_NONE || showtimeMode == SHOWTIME_MODES::SHOWTIME_FILE_TOTAL)
-{}
+    , mShow(showtimeMode != SHOWTIME_MODES::SHOWTIME_NONE && showtimeMode != SHOWTIME_MODES::SHOWTIME_FILE_TOTAL)
+    , mTrace(TimerTrace::enabled())
+{
+    start();
+}
 
 Timer::Timer(bool fileTotal, std::string filename)
     : mStr(std::move(filename))
-    , mStopped(!fileTotal)
-{}
+    , mShow(fileTotal)
+    , mTrace(TimerTrace::enabled())
+{
+    start();
+}
 
 Timer::~Timer()
 {
     stop();
 }
 
+void Timer::start()
+{
+    mStopped = !mShow && !mTrace;
+    if (mStopped)
+        return;
+    mStart = std::chrono::steady_clock::now();
+    mStartCpu = threadCpuTime();
+}
+
 void Timer::stop()
 {
-    if ((mShowTimeMode != SHOWTIME_MODES::SHOWTIME_NONE) && !mStopped) {
-        const std::clock_t end = std::clock();
-        const std::clock_t diff = end - mStart;
-
-        if (mShowTimeMode == SHOWTIME_MODES::SHOWTIME_FILE) {
-            const double sec = static_cast<double>(diff) / CLOCKS_PER_SEC;
-            std::lock_guard<std::mutex> l(stdCoutLock);
-            std::cout << mStr << ": " << sec << "s" << std::endl;
-        } else if (mShowTimeMode == SHOWTIME_MODES::SHOWTIME_FILE_TOTAL) {
-            const double sec = static_cast<double>(diff) / CLOCKS_PER_SEC;
-            std::lock_guard<std::mutex> l(stdCoutLock);
-            std::cout << "Check time: " << mStr << ": " << sec << "s" << std::endl;
-        } else {
-            if (mTimerResults)
-                mTimerResults->addResults(mStr, diff);
+    if (!mStopped) {
+        const std::chrono::nanoseconds wall = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart);
+        const std::chrono::nanoseconds cpu = threadCpuTime() - mStartCpu;
+
+        if (mTrace)
+            TimerTrace::add(mStr, mStart, wall, cpu);
+
+        if (mShow) {
+            if (mShowTimeMode == SHOWTIME_MODES::SHOWTIME_FILE) {
+                const double sec = std::chrono::duration<double>(wall).count();
+                std::lock_guard<std::mutex> l(stdCoutLock);
+                std::cout << mStr << ": " << sec << "s" << std::endl;
+            } else if (mShowTimeMode == SHOWTIME_MODES::SHOWTIME_FILE_TOTAL) {
+                const double sec = std::chrono::duration<double>(wall).count();
+                std::lock_guard<std::mutex> l(stdCoutLock);
+                std::cout << "Check time: " << mStr << ": " << sec << "s" << std::endl;
+            } else if (mTimerResults) {
+                mTimerResults->addResults(mStr, wall, cpu);
+            }
         }
     }
 
@@ -22,13 +22,15 @@
 
 #include "config.h"
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <ctime>
 #include <functional>
 #include <map>
 #include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 enum class SHOWTIME_MODES : std::uint8_t {
     SHOWTIME_NONE,
@@ -43,16 +45,26 @@ class CPPCHECKLIB TimerResultsIntf {
 public:
     virtual ~TimerResultsIntf() = default;
 
-    virtual void addResults(const std::string& str, std::clock_t clocks) = 0;
+    /** add the measured wall clock and thread CPU time */
+    virtual void addResults(const std::string& str, std::chrono::nanoseconds wall, std::chrono::nanoseconds cpu) = 0;
+
+    /** add to a counter that is shown along with the timer results (not in the top5 modes) */
+    virtual void addCount(const std::string& str, std::size_t count) = 0;
 };
 
 struct TimerResultsData {
-    std::clock_t mClocks{};
+    std::chrono::nanoseconds mWall{};
+    std::chrono::nanoseconds mCpu{};
     long mNumberOfResults{};
 
+    /** wall clock seconds */
     double seconds() const {
-        const double ret = static_cast<double>(static_cast<unsigned long>(mClocks)) / static_cast<double>(CLOCKS_PER_SEC);
-        return ret;
+        return std::chrono::duration<double>(mWall).count();
+    }
+
+    /** CPU seconds of the measuring thread */
+    double cpuSeconds() const {
+        return std::chrono::duration<double>(mCpu).count();
     }
 };
 
@@ -61,15 +73,61 @@ public:
     TimerResults() = default;
 
     void showResults(SHOWTIME_MODES mode) const;
-    void addResults(const std::string& str, std::clock_t clocks) override;
+    void addResults(const std::string& str, std::chrono::nanoseconds wall, std::chrono::nanoseconds cpu) override;
+    void addCount(const std::string& str, std::size_t count) override;
 
     void reset();
 
 private:
     std::map<std::string, TimerResultsData> mResults;
+    std::map<std::string, std::size_t> mCounts;
+    mutable std::mutex mResultsSync;
+};
+
+/** Keeps the slowest of the measured results, e.g. the checks of the analyzed files */
+class CPPCHECKLIB TimerSlowest {
+public:
+    /** add a result, only the max slowest results are kept */
+    void add(std::string str, std::chrono::nanoseconds wall, std::size_t max);
+
+    /** @return the kept results, the slowest first */
+    std::vector<std::pair<std::string, std::chrono::nanoseconds>> results() const;
+
+    void showResults(const std::string& title) const;
+
+    void reset();
+
+private:
+    std::vector<std::pair<std::string, std::chrono::nanoseconds>> mResults;
     mutable std::mutex mResultsSync;
 };
 
+/**
+ * Collects the timer scopes of all threads while it is enabled so they can be written as
+ * a Chrome trace event file (chrome://tracing, https://ui.perfetto.dev). The scopes of a
+ * thread are nested by their time ranges: file, configuration, tokenizer phase, ValueFlow
+ * pass and check.
+ */
+class CPPCHECKLIB TimerTrace {
+public:
+    /** start collecting the timer scopes */
+    static void start();
+
+    /** stop collecting and drop the collected scopes */
+    static void reset();
+
+    static bool enabled();
+
+    /** add a finished scope of the current thread */
+    static void add(const std::string& name, std::chrono::steady_clock::time_point start, std::chrono::nanoseconds wall, std::chrono::nanoseconds cpu);
+
+    /** @return the collected scopes in the trace event format */
+    static std::string toJson();
+
+    /** write the collected scopes to a file, @return false if it could not be written */
+    static bool write(const std::string& filename);
+};
+
 class CPPCHECKLIB Timer {
 public:
     Timer(std::string str, SHOWTIME_MODES showtimeMode, TimerResultsIntf* timerResults = nullptr);
@@ -86,11 +144,21 @@ public:
         f();
     }
 
+    /** CPU time that has been used by the current thread */
+    static std::chrono::nanoseconds threadCpuTime();
+
 private:
+    void start();
+
     const std::string mStr;
     TimerResultsIntf* mTimerResults{};
-    std::clock_t mStart = std::clock();
+    std::chrono::steady_clock::time_point mStart;
+    std::chrono::nanoseconds mStartCpu{};
     const SHOWTIME_MODES mShowTimeMode = SHOWTIME_MODES::SHOWTIME_FILE_TOTAL;
+    /** the time is shown or added to the results */
+    bool mShow{};
+    /** the scope is added to the trace */
+    bool mTrace{};
     bool mStopped{};
 };
 //---------------------------------------------------------------------------
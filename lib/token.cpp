@@ -26,6 +26,7 @@
 #include "simplecpp.h"
 #include "symboldatabase.h"
 #include "tokenlist.h"
+#include "tokenmatch.h"
 #include "utils.h"
 #include "tokenrange.h"
 #include "valueflow.h"
@@ -41,6 +42,7 @@
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <new>
 #include <set>
 #include <sstream>
 #include <stack>
@@ -63,10 +65,11 @@ const std::string Token::mEmptyString;
 Token::Token(const TokenList& tokenlist, std::shared_ptr<TokensFrontBack> tokensFrontBack)
     : mList(tokenlist)
     , mTokensFrontBack(std::move(tokensFrontBack))
+    , mStr(&mEmptyString)
     , mIsC(mList.isC())
     , mIsCpp(mList.isCPP())
 {
-    mImpl = new TokenImpl();
+    mImpl = new (mTokensFrontBack->arena.allocate(sizeof(TokenImpl))) TokenImpl();
 }
 
 Token::Token(const Token* tok)
@@ -78,7 +81,39 @@ Token::Token(const Token* tok)
 
 Token::~Token()
 {
-    delete mImpl;
+    if (mImpl) {
+        forgetValues();
+        mImpl->~TokenImpl();
+    }
+    // mTokensFrontBack is destroyed last, it might release the memory of this token
+}
+
+void *Token::operator new(std::size_t size, TokenArena &arena)
+{
+    return arena.allocate(size);
+}
+
+void Token::operator delete(void * /*p*/, TokenArena & /*arena*/) noexcept
+{}
+
+Token *Token::create(const Token *tok)
+{
+    return new (tok->mTokensFrontBack->arena) Token(tok);
+}
+
+void Token::forgetValues()
+{
+    if (mImpl->mValues) {
+        mTokensFrontBack->valueCount -= mImpl->mValues->size();
+        valuesChanged();
+    }
+}
+
+void Token::valuesChanged() const
+{
+    std::vector<const Scope*>* const scopes = mTokensFrontBack->valueChangedScopes;
+    if (scopes && (scopes->empty() || scopes->back() != mImpl->mScope))
+        scopes->push_back(mImpl->mScope);
 }
 
 /*
@@ -92,6 +127,13 @@ ConstTokenRange Token::until(const Token* t) const
     return ConstTokenRange(this, t);
 }
 
+void Token::internStr(const std::string &s)
+{
+    const std::pair<const std::string, nonneg int> &interned = mTokensFrontBack->strings.intern(s);
+    mStr = &interned.first;
+    mStrId = interned.second;
+}
+
 static const std::unordered_set<std::string> controlFlowKeywords = {
     "goto",
     "do",
@@ -114,8 +156,8 @@ void Token::update_property_info()
     // TODO: clear fIsLong
     isStandardType(false);
 
-    if (!mStr.empty()) {
-        if (mStr == "true" || mStr == "false") {
+    if (!str().empty()) {
+        if (str() == "true" || str() == "false") {
             if (mImpl->mVarId) {
                 if (mIsCpp)
                     throw InternalError(this, "Internal error. VarId set for bool literal.");
@@ -124,24 +166,24 @@ void Token::update_property_info()
             else
                 tokType(eBoolean);
         }
-        else if (isStringLiteral(mStr)) {
+        else if (isStringLiteral(str())) {
             tokType(eString);
-            isLong(isPrefixStringCharLiteral(mStr, '"', "L"));
+            isLong(isPrefixStringCharLiteral(str(), '"', "L"));
         }
-        else if (isCharLiteral(mStr)) {
+        else if (isCharLiteral(str())) {
             tokType(eChar);
-            isLong(isPrefixStringCharLiteral(mStr, '\'', "L"));
+            isLong(isPrefixStringCharLiteral(str(), '\'', "L"));
         }
-        else if (std::isalpha(static_cast<unsigned char>(mStr[0])) || mStr[0] == '_' || mStr[0] == '$') { // Name
+        else if (std::isalpha(static_cast<unsigned char>(str()[0])) || str()[0] == '_' || str()[0] == '$') { // Name
             if (mImpl->mVarId)
                 tokType(eVariable);
-            else if (mList.isKeyword(mStr)) {
+            else if (mList.isKeyword(str())) {
                 tokType(eKeyword);
                 update_property_isStandardType();
                 if (mTokType != eType) // cannot be a control-flow keyword when it is a type
-                    setFlag(fIsControlFlowKeyword, controlFlowKeywords.find(mStr) != controlFlowKeywords.end());
+                    setFlag(fIsControlFlowKeyword, controlFlowKeywords.find(str()) != controlFlowKeywords.end());
             }
-            else if (mStr == "asm") { // TODO: not a keyword
+            else if (str() == "asm") { // TODO: not a keyword
                 tokType(eKeyword);
             }
             else {
@@ -149,43 +191,43 @@ void Token::update_property_info()
                 // some types are not being treated as keywords
                 update_property_isStandardType();
             }
-        } else if (simplecpp::Token::isNumberLike(mStr)) {
-            if ((MathLib::isInt(mStr) || MathLib::isFloat(mStr)) && mStr.find('_') == std::string::npos)
+        } else if (simplecpp::Token::isNumberLike(str())) {
+            if ((MathLib::isInt(str()) || MathLib::isFloat(str())) && str().find('_') == std::string::npos)
                 tokType(eNumber);
             else
                 tokType(eName); // assume it is a user defined literal
-        } else if (mStr == "=" || mStr == "<<=" || mStr == ">>=" ||
-                   (mStr.size() == 2U && mStr[1] == '=' && std::strchr("+-*/%&^|", mStr[0])))
+        } else if (str() == "=" || str() == "<<=" || str() == ">>=" ||
+                   (str().size() == 2U && str()[1] == '=' && std::strchr("+-*/%&^|", str()[0])))
             tokType(eAssignmentOp);
-        else if (mStr.size() == 1 && mStr.find_first_of(",[]()?:") != std::string::npos)
+        else if (str().size() == 1 && str().find_first_of(",[]()?:") != std::string::npos)
             tokType(eExtendedOp);
-        else if (mStr=="<<" || mStr==">>" || (mStr.size()==1 && mStr.find_first_of("+-*/%") != std::string::npos))
+        else if (str()=="<<" || str()==">>" || (str().size()==1 && str().find_first_of("+-*/%") != std::string::npos))
             tokType(eArithmeticalOp);
-        else if (mStr.size() == 1 && mStr.find_first_of("&|^~") != std::string::npos)
+        else if (str().size() == 1 && str().find_first_of("&|^~") != std::string::npos)
             tokType(eBitOp);
-        else if (mStr.size() <= 2 &&
-                 (mStr == "&&" ||
-                  mStr == "||" ||
-                  mStr == "!"))
+        else if (str().size() <= 2 &&
+                 (str() == "&&" ||
+                  str() == "||" ||
+                  str() == "!"))
             tokType(eLogicalOp);
         // TODO: should link check only apply to < and >? Token::link() suggests so
-        else if (mStr.size() <= 2 && !mLink &&
-                 (mStr == "==" ||
-                  mStr == "!=" ||
-                  mStr == "<" ||
-                  mStr == "<=" ||
-                  mStr == ">" ||
-                  mStr == ">="))
+        else if (str().size() <= 2 && !mLink &&
+                 (str() == "==" ||
+                  str() == "!=" ||
+                  str() == "<" ||
+                  str() == "<=" ||
+                  str() == ">" ||
+                  str() == ">="))
             tokType(eComparisonOp);
-        else if (mStr == "<=>")
+        else if (str() == "<=>")
             tokType(eComparisonOp);
-        else if (mStr.size() == 2 &&
-                 (mStr == "++" ||
-                  mStr == "--"))
+        else if (str().size() == 2 &&
+                 (str() == "++" ||
+                  str() == "--"))
             tokType(eIncDecOp);
-        else if (mStr.size() == 1 && (mStr.find_first_of("{}") != std::string::npos || (mLink && mStr.find_first_of("<>") != std::string::npos)))
+        else if (str().size() == 1 && (str().find_first_of("{}") != std::string::npos || (mLink && str().find_first_of("<>") != std::string::npos)))
             tokType(eBracket);
-        else if (mStr == "...")
+        else if (str() == "...")
             tokType(eEllipsis);
         else
             tokType(eOther);
@@ -218,10 +260,10 @@ bool Token::isStandardType(const std::string& str)
 
 void Token::update_property_isStandardType()
 {
-    if (mStr.size() < 3 || mStr.size() > 7)
+    if (str().size() < 3 || str().size() > 7)
         return;
 
-    if (isStandardType(mStr)) {
+    if (isStandardType(str())) {
         isStandardType(true);
         tokType(eType);
     }
@@ -231,26 +273,28 @@ bool Token::isUpperCaseName() const
 {
     if (!isName())
         return false;
-    return std::none_of(mStr.begin(), mStr.end(), [](char c) {
+    return std::none_of(str().begin(), str().end(), [](char c) {
         return std::islower(c);
     });
 }
 
 void Token::concatStr(std::string const& b)
 {
-    mStr.pop_back();
-    mStr.append(getStringLiteral(b) + "\"");
+    std::string s = *mStr;
+    s.pop_back();
+    s.append(getStringLiteral(b) + "\"");
 
     if (isCChar() && isStringLiteral(b) && b[0] != '"') {
-        mStr.insert(0, b.substr(0, b.find('"')));
+        s.insert(0, b.substr(0, b.find('"')));
     }
+    internStr(s);
     update_property_info();
 }
 
 std::string Token::strValue() const
 {
     assert(mTokType == eString);
-    std::string ret(getStringLiteral(mStr));
+    std::string ret(getStringLiteral(str()));
     std::string::size_type pos = 0U;
     while ((pos = ret.find('\\', pos)) != std::string::npos) {
         ret.erase(pos,1U);
@@ -313,6 +357,7 @@ void Token::swapWithNext()
 {
     if (mNext) {
         std::swap(mStr, mNext->mStr);
+        std::swap(mStrId, mNext->mStrId);
         std::swap(mTokType, mNext->mTokType);
         std::swap(mFlags, mNext->mFlags);
         std::swap(mImpl, mNext->mImpl);
@@ -338,9 +383,11 @@ void Token::swapWithNext()
 void Token::takeData(Token *fromToken)
 {
     mStr = fromToken->mStr;
+    mStrId = fromToken->mStrId;
     tokType(fromToken->mTokType);
     mFlags = fromToken->mFlags;
-    delete mImpl;
+    forgetValues();
+    mImpl->~TokenImpl();
     mImpl = fromToken->mImpl;
     fromToken->mImpl = nullptr;
     if (mImpl->mTemplateSimplifierPointers)
@@ -515,7 +562,8 @@ int multiComparePercent(const Token *tok, const char*& haystack, nonneg int vari
             // Or (%or%)
             else {
                 haystack += 2;
-                if (tok->tokType() == Token::eBitOp && tok->str() == "|")
+                static const nonneg int orId = TokenStrings::fixedId("|");
+                if (tok->tokType() == Token::eBitOp && tok->strId() == orId)
                     return 1;
             }
         }
@@ -523,7 +571,8 @@ int multiComparePercent(const Token *tok, const char*& haystack, nonneg int vari
         // Oror (%oror%)
         else {
             haystack += 4;
-            if (tok->tokType() == Token::eLogicalOp && tok->str() == "||")
+            static const nonneg int ororId = TokenStrings::fixedId("||");
+            if (tok->tokType() == Token::eLogicalOp && tok->strId() == ororId)
                 return 1;
         }
     }
@@ -619,7 +668,7 @@ bool Token::simpleMatch(const Token *tok, const char pattern[], size_t pattern_l
     while (*current) {
         const std::size_t length = next - current;
 
-        if (!tok || length != tok->mStr.length() || std::strncmp(current, tok->mStr.c_str(), length) != 0)
+        if (!tok || length != tok->mStr->length() || std::strncmp(current, tok->mStr->c_str(), length) != 0)
             return false;
 
         current = next;
@@ -816,9 +865,9 @@ static T* nextArgumentImpl(T *thisTok)
     for (T* tok = thisTok; tok; tok = tok->next()) {
         if (tok->str() == ",")
             return tok->next();
-        if (tok->link() && Token::Match(tok, "(|{|[|<"))
+        if (tok->link() && TOKEN_MATCH(tok, "(|{|[|<"))
             tok = tok->link();
-        else if (Token::Match(tok, ")|;"))
+        else if (TOKEN_MATCH(tok, ")|;"))
             return nullptr;
     }
     return nullptr;
@@ -839,13 +888,13 @@ const Token* Token::nextArgumentBeforeCreateLinks2() const
     for (const Token* tok = this; tok; tok = tok->next()) {
         if (tok->str() == ",")
             return tok->next();
-        if (tok->link() && Token::Match(tok, "(|{|["))
+        if (tok->link() && TOKEN_MATCH(tok, "(|{|["))
             tok = tok->link();
         else if (tok->str() == "<") {
             const Token* temp = tok->findClosingBracket();
             if (temp)
                 tok = temp;
-        } else if (Token::Match(tok, ")|;"))
+        } else if (TOKEN_MATCH(tok, ")|;"))
             return nullptr;
     }
     return nullptr;
@@ -856,9 +905,9 @@ const Token* Token::nextTemplateArgument() const
     for (const Token* tok = this; tok; tok = tok->next()) {
         if (tok->str() == ",")
             return tok->next();
-        if (tok->link() && Token::Match(tok, "(|{|[|<"))
+        if (tok->link() && TOKEN_MATCH(tok, "(|{|[|<"))
             tok = tok->link();
-        else if (Token::Match(tok, ">|;"))
+        else if (TOKEN_MATCH(tok, ">|;"))
             return nullptr;
     }
     return nullptr;
@@ -874,15 +923,15 @@ static bool isOperator(const Token *tok)
 
 const Token * Token::findClosingBracket() const
 {
-    if (mStr != "<")
+    if (str() != "<")
         return nullptr;
 
     if (!mPrevious)
         return nullptr;
 
     if (!(mPrevious->isName() || Token::simpleMatch(mPrevious, "]") ||
-          Token::Match(mPrevious->previous(), "operator %op% <") ||
-          Token::Match(mPrevious->tokAt(-2), "operator [([] [)]] <")))
+          TOKEN_MATCH(mPrevious->previous(), "operator %op% <") ||
+          TOKEN_MATCH(mPrevious->tokAt(-2), "operator [([] [)]] <")))
         return nullptr;
 
     const Token *closing = nullptr;
@@ -895,17 +944,17 @@ const Token * Token::findClosingBracket() const
             isDecl = false;
         if (Token::simpleMatch(prev, "template <"))
             isDecl = true;
-        if (Token::Match(prev, "[;{}]"))
+        if (TOKEN_MATCH(prev, "[;{}]"))
             break;
     }
 
     unsigned int depth = 0;
     for (closing = this; closing != nullptr; closing = closing->next()) {
-        if (Token::Match(closing, "{|[|(")) {
+        if (TOKEN_MATCH(closing, "{|[|(")) {
             closing = closing->link();
             if (!closing)
                 return nullptr; // #6803
-        } else if (Token::Match(closing, "}|]|)|;"))
+        } else if (TOKEN_MATCH(closing, "}|]|)|;"))
             return nullptr;
         // we can make some guesses for template parameters
         else if (closing->str() == "<" && closing->previous() &&
@@ -923,8 +972,8 @@ const Token * Token::findClosingBracket() const
             depth -= 2;
         }
         // save named template parameter
-        else if (templateParameter && depth == 1 && Token::Match(closing, "[,=]") &&
-                 closing->previous()->isName() && !Token::Match(closing->previous(), "class|typename|.") && !Token::Match(closing->tokAt(-2), "=|::"))
+        else if (templateParameter && depth == 1 && TOKEN_MATCH(closing, "[,=]") &&
+                 closing->previous()->isName() && !TOKEN_MATCH(closing->previous(), "class|typename|.") && !TOKEN_MATCH(closing->tokAt(-2), "=|::"))
             templateParameters.insert(closing->strAt(-1));
     }
 
@@ -939,18 +988,18 @@ Token * Token::findClosingBracket()
 
 const Token * Token::findOpeningBracket() const
 {
-    if (mStr != ">")
+    if (str() != ">")
         return nullptr;
 
     const Token *opening = nullptr;
 
     unsigned int depth = 0;
     for (opening = this; opening != nullptr; opening = opening->previous()) {
-        if (Token::Match(opening, "}|]|)")) {
+        if (TOKEN_MATCH(opening, "}|]|)")) {
             opening = opening->link();
             if (!opening)
                 return nullptr;
-        } else if (Token::Match(opening, "{|{|(|;"))
+        } else if (TOKEN_MATCH(opening, "{|{|(|;"))
             return nullptr;
         else if (opening->str() == ">")
             ++depth;
@@ -1063,10 +1112,10 @@ void Token::function(const Function *f)
 Token* Token::insertToken(const std::string& tokenStr, const std::string& originalNameStr, const std::string& macroNameStr, bool prepend)
 {
     Token *newToken;
-    if (mStr.empty())
+    if (str().empty())
         newToken = this;
     else
-        newToken = new Token(mList, mTokensFrontBack);
+        newToken = new (mTokensFrontBack->arena) Token(mList, mTokensFrontBack);
     newToken->str(tokenStr);
     if (!originalNameStr.empty())
         newToken->originalName(originalNameStr);
@@ -1271,15 +1320,15 @@ std::string Token::stringify(const stringifyOptions& options) const
     }
     if (options.macro && isExpandedMacro())
         ret += '$';
-    if (isName() && mStr.find(' ') != std::string::npos) {
-        for (const char i : mStr) {
+    if (isName() && str().find(' ') != std::string::npos) {
+        for (const char i : str()) {
             if (i != ' ')
                 ret += i;
         }
-    } else if (mStr[0] != '\"' || mStr.find('\0') == std::string::npos)
-        ret += mStr;
+    } else if (str()[0] != '\"' || str().find('\0') == std::string::npos)
+        ret += str();
     else {
-        for (const char i : mStr) {
+        for (const char i : str()) {
             if (i == '\0')
                 ret += "\\0";
             else
@@ -1694,7 +1743,7 @@ void Token::astStringVerboseRecursive(std::string& ret, const nonneg int indent1
 {
     if (isExpandedMacro())
         ret += '$';
-    ret += mStr;
+    ret += str();
     if (mImpl->mValueType)
         ret += " \'" + mImpl->mValueType->str() + '\'';
     if (function()) {
@@ -2213,7 +2262,41 @@ static bool sameValueType(const ValueFlow::Value& x, const ValueFlow::Value& y)
     return true;
 }
 
+void Token::removeValues(std::function<bool(const ValueFlow::Value &)> pred)
+{
+    if (mImpl->mValues) {
+        const std::size_t size = mImpl->mValues->size();
+        mImpl->mValues->remove_if(std::move(pred));
+        if (size != mImpl->mValues->size()) {
+            mTokensFrontBack->valueCount -= size - mImpl->mValues->size();
+            valuesChanged();
+        }
+    }
+}
+
+void Token::clearValueFlow()
+{
+    forgetValues();
+    delete mImpl->mValues;
+    mImpl->mValues = nullptr;
+}
+
 bool Token::addValue(const ValueFlow::Value &value)
+{
+    const std::size_t size = mImpl->mValues ? mImpl->mValues->size() : 0;
+    const bool added = addValueInternal(value);
+    const std::size_t newSize = mImpl->mValues ? mImpl->mValues->size() : 0;
+    if (added)
+        ++mTokensFrontBack->addedValues;
+    if (added || size != newSize) {
+        mTokensFrontBack->valueCount += newSize;
+        mTokensFrontBack->valueCount -= size;
+        valuesChanged();
+    }
+    return added;
+}
+
+bool Token::addValueInternal(const ValueFlow::Value &value)
 {
     if (value.isKnown() && mImpl->mValues) {
         // Clear all other values of the same type since value is known
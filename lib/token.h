@@ -52,6 +52,7 @@ class Variable;
 class ConstTokenRange;
 class Token;
 struct TokensFrontBack;
+class TokenArena;
 class TokenList;
 
 struct ScopeInfo2 {
@@ -191,11 +192,23 @@ public:
     explicit Token(const Token *tok);
     ~Token();
 
+    /**
+     * Tokens are allocated in the arena of their token list, the memory is released
+     * with the arena and deleting a token only destroys it.
+     */
+    static void *operator new(std::size_t size, TokenArena &arena);
+    static void operator delete(void *p, TokenArena &arena) noexcept;
+    static void *operator new(std::size_t size) = delete;
+    static void operator delete(void * /*p*/) noexcept {}
+
+    /** Create a token in the same token list as tok, for usage in CheckIO::ArgumentInfo only */
+    static Token *create(const Token *tok);
+
     ConstTokenRange until(const Token * t) const;
 
     template<typename T>
     void str(T&& s) {
-        mStr = s;
+        internStr(s);
         mImpl->mVarId = 0;
 
         update_property_info();
@@ -208,7 +221,15 @@ public:
     void concatStr(std::string const& b);
 
     const std::string &str() const {
-        return mStr;
+        return *mStr;
+    }
+
+    /**
+     * @return id of the string in the interned strings of the token list,
+     * equal strings have the same id. @see TokenStrings
+     */
+    nonneg int strId() const {
+        return mStrId;
     }
 
     /**
@@ -260,7 +281,7 @@ public:
     const std::string &strAt(int index) const
     {
         const Token *tok = this->tokAt(index);
-        return tok ? tok->mStr : mEmptyString;
+        return tok ? *tok->mStr : mEmptyString;
     }
 
     /**
@@ -440,7 +461,7 @@ public:
         return astOperand1() != nullptr && astOperand2() != nullptr;
     }
     bool isUnaryOp(const std::string &s) const {
-        return s == mStr && astOperand1() != nullptr && astOperand2() == nullptr;
+        return s == *mStr && astOperand1() != nullptr && astOperand2() == nullptr;
     }
     bool isUnaryPreOp() const;
 
@@ -765,27 +786,27 @@ public:
     }
 
     bool isUtf8() const {
-        return (((mTokType == eString) && isPrefixStringCharLiteral(mStr, '"', "u8")) ||
-                ((mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', "u8")));
+        return (((mTokType == eString) && isPrefixStringCharLiteral(*mStr, '"', "u8")) ||
+                ((mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', "u8")));
     }
 
     bool isUtf16() const {
-        return (((mTokType == eString) && isPrefixStringCharLiteral(mStr, '"', "u")) ||
-                ((mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', "u")));
+        return (((mTokType == eString) && isPrefixStringCharLiteral(*mStr, '"', "u")) ||
+                ((mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', "u")));
     }
 
     bool isUtf32() const {
-        return (((mTokType == eString) && isPrefixStringCharLiteral(mStr, '"', "U")) ||
-                ((mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', "U")));
+        return (((mTokType == eString) && isPrefixStringCharLiteral(*mStr, '"', "U")) ||
+                ((mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', "U")));
     }
 
     bool isCChar() const {
-        return (((mTokType == eString) && isPrefixStringCharLiteral(mStr, '"', emptyString)) ||
-                ((mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', emptyString) && (replaceEscapeSequences(getCharLiteral(mStr)).size() == 1)));
+        return (((mTokType == eString) && isPrefixStringCharLiteral(*mStr, '"', emptyString)) ||
+                ((mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', emptyString) && (replaceEscapeSequences(getCharLiteral(*mStr)).size() == 1)));
     }
 
     bool isCMultiChar() const {
-        return (mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', emptyString) && (replaceEscapeSequences(getCharLiteral(mStr)).size() > 1);
+        return (mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', emptyString) && (replaceEscapeSequences(getCharLiteral(*mStr)).size() > 1);
     }
 
     /**
@@ -1106,7 +1127,7 @@ public:
             return;
 
         mLink = linkToToken;
-        if (mStr == "<" || mStr == ">")
+        if (*mStr == "<" || *mStr == ">")
             update_property_info();
     }
 
@@ -1337,10 +1358,7 @@ public:
     /** Add token value. Return true if value is added. */
     bool addValue(const ValueFlow::Value &value);
 
-    void removeValues(std::function<bool(const ValueFlow::Value &)> pred) {
-        if (mImpl->mValues)
-            mImpl->mValues->remove_if(std::move(pred));
-    }
+    void removeValues(std::function<bool(const ValueFlow::Value &)> pred);
 
     nonneg int index() const {
         return mImpl->mIndex;
@@ -1360,6 +1378,14 @@ private:
     /** used by deleteThis() to take data from token to delete */
     void takeData(Token *fromToken);
 
+    bool addValueInternal(const ValueFlow::Value &value);
+
+    /** remove the values of this token from the value count of the token list */
+    void forgetValues();
+
+    /** record the scope of this token when the changed scopes are tracked by the token list */
+    void valuesChanged() const;
+
     /**
      * Works almost like strcmp() except returns only true or false and
      * if str has empty space &apos; &apos; character, that character is handled
@@ -1374,7 +1400,8 @@ private:
      */
     static const char *chrInFirstWord(const char *str, char c);
 
-    std::string mStr;
+    /** interned string of the token */
+    const std::string *mStr;
 
     Token* mNext{};
     Token* mPrevious{};
@@ -1433,6 +1460,8 @@ private:
         efIsUnique = efMaxSize - 2,
     };
 
+    nonneg int mStrId{};
+
     Token::Type mTokType = eNone;
 
     uint64_t mFlags{};
@@ -1457,6 +1486,9 @@ private:
         mFlags = state_ ? mFlags | flag_ : mFlags & ~flag_;
     }
 
+    /** Set mStr and mStrId to the interned string s */
+    void internStr(const std::string &s);
+
     /** Updates internal property cache like _isName or _isBoolean.
         Called after any mStr() modification. */
     void update_property_info();
@@ -1539,10 +1571,7 @@ public:
      */
     bool isCalculation() const;
 
-    void clearValueFlow() {
-        delete mImpl->mValues;
-        mImpl->mValues = nullptr;
-    }
+    void clearValueFlow();
 
     std::string astString(const char *sep = "") const {
         std::string ret;
@@ -1550,7 +1579,7 @@ public:
             ret = mImpl->mAstOperand1->astString(sep);
         if (mImpl->mAstOperand2)
             ret += mImpl->mAstOperand2->astString(sep);
-        return ret + sep + mStr;
+        return ret + sep + *mStr;
     }
 
     std::string astStringVerbose() const;
@@ -124,6 +124,11 @@ Tokenizer::Tokenizer(TokenList tokenList, ErrorLogger &errorLogger) :
 
 Tokenizer::~Tokenizer()
 {
+    if (mTimerResults && mSettings.showtime != SHOWTIME_MODES::SHOWTIME_NONE) {
+        mTimerResults->addCount("Tokenizer::tokenArena::allocations", list.getArena().allocations());
+        mTimerResults->addCount("Tokenizer::tokenArena::blocks", list.getArena().blocks());
+        mTimerResults->addCount("Tokenizer::tokenStrings", list.getStrings().size());
+    }
     delete mSymbolDatabase;
     delete mTemplateSimplifier;
 }
@@ -34,14 +34,18 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <mutex>
+#include <new>
 #include <utility>
 #include <set>
 #include <stack>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <simplecpp.h>
@@ -52,6 +56,95 @@
 static constexpr int AST_MAX_DEPTH = 150;
 
 
+namespace {
+    constexpr std::size_t arenaAlignment = alignof(std::max_align_t);
+    constexpr std::size_t arenaBlockSize = 256 * 1024;
+}
+
+TokenArena::~TokenArena()
+{
+    for (void *block : mBlocks)
+        ::operator delete(block);
+}
+
+void *TokenArena::allocate(std::size_t size)
+{
+    size = (size + arenaAlignment - 1) & ~(arenaAlignment - 1);
+
+    std::lock_guard<std::mutex> lock(mSync);
+    ++mAllocations;
+    if (size > mAvailable) {
+        if (size > arenaBlockSize / 4) {
+            // large allocations get their own block so the current block can still be used
+            mBlocks.push_back(::operator new(size));
+            return mBlocks.back();
+        }
+        mBlocks.push_back(::operator new(arenaBlockSize));
+        mCurrent = static_cast<char *>(mBlocks.back());
+        mAvailable = arenaBlockSize;
+    }
+    void * const ret = mCurrent;
+    mCurrent += size;
+    mAvailable -= size;
+    return ret;
+}
+
+std::size_t TokenArena::allocations() const
+{
+    std::lock_guard<std::mutex> lock(mSync);
+    return mAllocations;
+}
+
+std::size_t TokenArena::blocks() const
+{
+    std::lock_guard<std::mutex> lock(mSync);
+    return mBlocks.size();
+}
+
+TokenStrings::TokenStrings()
+{
+    mIds.reserve(1024);
+    mIds.emplace("", 0);
+    nonneg int id = 0;
+    for (const char *s : TokenStringIds::fixedStrings)
+        mIds.emplace(s, ++id);
+    assert(mIds.size() == maxFixedId() + 1U);
+}
+
+const std::pair<const std::string, nonneg int> &TokenStrings::intern(const std::string &s)
+{
+    std::lock_guard<std::mutex> lock(mSync);
+    const auto it = mIds.find(s);
+    if (it != mIds.end())
+        return *it;
+    const nonneg int id = mIds.size();
+    return *mIds.emplace(s, id).first;
+}
+
+nonneg int TokenStrings::fixedId(const std::string &s)
+{
+    static const std::unordered_map<std::string, nonneg int> fixedIds = [] {
+        std::unordered_map<std::string, nonneg int> ids;
+        nonneg int id = 0;
+        for (const char *str : TokenStringIds::fixedStrings)
+            ids.emplace(str, ++id);
+        return ids;
+    }();
+    const auto it = fixedIds.find(s);
+    return it != fixedIds.end() ? it->second : 0;
+}
+
+nonneg int TokenStrings::maxFixedId()
+{
+    return TokenStringIds::count;
+}
+
+std::size_t TokenStrings::size() const
+{
+    std::lock_guard<std::mutex> lock(mSync);
+    return mIds.size();
+}
+
 TokenList::TokenList(const Settings& settings, Standards::Language lang)
     : mTokensFrontBack(new TokensFrontBack)
     , mSettings(settings)
@@ -147,7 +240,7 @@ void TokenList::addtoken(const std::string& str, const nonneg int lineno, const
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(str);
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = new (mTokensFrontBack->arena) Token(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(str);
     }
@@ -165,7 +258,7 @@ void TokenList::addtoken(const std::string& str, const Token *locationTok)
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(str);
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = new (mTokensFrontBack->arena) Token(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(str);
     }
@@ -183,7 +276,7 @@ void TokenList::addtoken(const Token * tok, const nonneg int lineno, const nonne
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(tok->str(), tok->originalName());
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = new (mTokensFrontBack->arena) Token(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(tok->str());
         if (!tok->originalName().empty())
@@ -204,7 +297,7 @@ void TokenList::addtoken(const Token *tok, const Token *locationTok)
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(tok->str(), tok->originalName());
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = new (mTokensFrontBack->arena) Token(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(tok->str());
         if (!tok->originalName().empty())
@@ -225,7 +318,7 @@ void TokenList::addtoken(const Token *tok)
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(tok->str(), tok->originalName(), tok->getMacroName());
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = new (mTokensFrontBack->arena) Token(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(tok->str());
         if (!tok->originalName().empty())
@@ -362,7 +455,7 @@ void TokenList::createTokens(simplecpp::TokenList&& tokenList)
         if (mTokensFrontBack->back) {
             mTokensFrontBack->back->insertToken(str);
         } else {
-            mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+            mTokensFrontBack->front = new (mTokensFrontBack->arena) Token(*this, mTokensFrontBack);
             mTokensFrontBack->back = mTokensFrontBack->front;
             mTokensFrontBack->back->str(str);
         }
@@ -24,12 +24,17 @@
 #include "config.h"
 #include "standards.h"
 
+#include <atomic>
 #include <cstddef>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+class Scope;
 class Token;
 class Settings;
 
@@ -40,12 +45,118 @@ namespace simplecpp {
 /// @addtogroup Core
 /// @{
 
+/**
+ * @brief Memory for the tokens of a token list.
+ *
+ * The memory is allocated in large blocks and released all at once when the arena is
+ * destroyed, that is when the token list and all of its tokens have been destroyed.
+ */
+class CPPCHECKLIB TokenArena {
+public:
+    TokenArena() = default;
+    ~TokenArena();
+
+    TokenArena(const TokenArena &) = delete;
+    TokenArena &operator=(const TokenArena &) = delete;
+
+    /** allocate memory that is suitably aligned for any object */
+    void *allocate(std::size_t size);
+
+    /** number of allocations */
+    std::size_t allocations() const;
+
+    /** number of allocated blocks */
+    std::size_t blocks() const;
+
+private:
+    mutable std::mutex mSync;
+    std::vector<void *> mBlocks;
+    char *mCurrent{};
+    std::size_t mAvailable{};
+    std::size_t mAllocations{};
+};
+
+/** Fixed ids of the token strings, these can be used in constant expressions */
+namespace TokenStringIds {
+    /** the keywords and operators that have fixed ids, the id is the index + 1 */
+    constexpr const char *fixedStrings[] = {
+        // C and C++ keywords
+        "alignas", "alignof", "asm", "auto", "bool", "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t",
+        "class", "const", "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await", "co_return",
+        "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit",
+        "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable",
+        "namespace", "new", "noexcept", "nullptr", "operator", "private", "protected", "public", "register",
+        "reinterpret_cast", "requires", "restrict", "return", "short", "signed", "sizeof", "static", "static_assert",
+        "static_cast", "struct", "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef",
+        "typeid", "typename", "typeof", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while",
+        "_Alignas", "_Alignof", "_Atomic", "_Bool", "_Complex", "_Generic", "_Imaginary", "_Noreturn",
+        "_Static_assert", "_Thread_local",
+        // operators and punctuators
+        "{", "}", "[", "]", "(", ")", ";", ":", "::", ",", ".", "->", "...", "?", "#", "##",
+        "+", "-", "*", "/", "%", "^", "&", "|", "~", "!", "=", "<", ">", "<=", ">=", "==", "!=", "<=>",
+        "&&", "||", "<<", ">>", "++", "--", "+=", "-=", "*=", "/=", "%=", "^=", "&=", "|=", "<<=", ">>=",
+        ".*", "->*",
+        // common literals
+        "0", "1"
+    };
+
+    constexpr nonneg int count = sizeof(fixedStrings) / sizeof(fixedStrings[0]);
+
+    constexpr bool equals(const char *fixed, const char *s, std::size_t len) {
+        return len == 0 ? *fixed == '\0' : (*fixed == *s && equals(fixed + 1, s + 1, len - 1));
+    }
+
+    /** @return the fixed id of the string s with the length len, 0 if it has no fixed id */
+    constexpr nonneg int fixedId(const char *s, std::size_t len, nonneg int id = 1) {
+        return id > count ? 0 : (equals(fixedStrings[id - 1], s, len) ? id : fixedId(s, len, id + 1));
+    }
+}
+
+/**
+ * Interning table for the strings of the tokens of a list. Each distinct string
+ * is stored once and has an id. The empty string has the id 0 and the keywords
+ * and operators have the same fixed ids in all tables.
+ */
+class CPPCHECKLIB TokenStrings {
+public:
+    TokenStrings();
+
+    TokenStrings(const TokenStrings &) = delete;
+    TokenStrings &operator=(const TokenStrings &) = delete;
+
+    /** @return the interned string and its id */
+    const std::pair<const std::string, nonneg int> &intern(const std::string &s);
+
+    /** @return the fixed id of a keyword or operator, 0 for other strings */
+    static nonneg int fixedId(const std::string &s);
+
+    /** the ids that are larger are not fixed */
+    static nonneg int maxFixedId();
+
+    /** number of interned strings */
+    std::size_t size() const;
+
+private:
+    mutable std::mutex mSync;
+    std::unordered_map<std::string, nonneg int> mIds;
+};
+
 /**
  * @brief This struct stores pointers to the front and back tokens of the list this token is in.
  */
 struct TokensFrontBack {
     Token *front{};
     Token* back{};
+    /** number of ValueFlow values of all tokens, updated concurrently when function scopes are analyzed in parallel */
+    std::atomic<std::size_t> valueCount{};
+    /** number of ValueFlow values that have been added, removed values are not subtracted */
+    std::atomic<std::size_t> addedValues{};
+    /** when set, the scopes of the tokens whose ValueFlow values are changed are added */
+    std::vector<const Scope*>* valueChangedScopes{};
+    /** memory of the tokens */
+    TokenArena arena;
+    /** strings of the tokens */
+    TokenStrings strings;
 };
 
 class CPPCHECKLIB TokenList {
@@ -128,6 +239,31 @@ public:
         return mTokensFrontBack->back;
     }
 
+    /** get number of ValueFlow values of all tokens */
+    std::size_t getValueCount() const {
+        return mTokensFrontBack->valueCount;
+    }
+
+    /** get number of ValueFlow values that have been added to the tokens */
+    std::size_t getAddedValueCount() const {
+        return mTokensFrontBack->addedValues;
+    }
+
+    /** get the memory arena of the tokens */
+    const TokenArena &getArena() const {
+        return mTokensFrontBack->arena;
+    }
+
+    /** get the interned strings of the tokens */
+    const TokenStrings &getStrings() const {
+        return mTokensFrontBack->strings;
+    }
+
+    /** track the scopes of the tokens whose ValueFlow values are changed, nullptr stops the tracking */
+    void setValueChangedScopes(std::vector<const Scope*>* scopes) {
+        mTokensFrontBack->valueChangedScopes = scopes;
+    }
+
     /**
      * Get filenames (the sourcefile + the files it include).
      * The first filename is the filename for the sourcefile
@@ -0,0 +1,359 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef tokenmatchH
+#define tokenmatchH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+#include "errortypes.h"
+#include "token.h"
+#include "tokenlist.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Token::Match() patterns that are compiled by the C++ compiler.
+ *
+ * TOKEN_MATCH(tok, "%var% = %num% ;") has the same result as
+ * Token::Match(tok, "%var% = %num% ;") but the pattern is parsed at compile time
+ * into a matcher for each of its words. The literal words that are keywords or
+ * operators are compared by the id of the token string. The pattern has to be a
+ * string literal, an unknown %cmd% is a compile error.
+ */
+namespace TokenMatch {
+    /** @return the position after the word that starts at pos */
+    constexpr std::size_t wordEnd(const char *p, std::size_t pos) {
+        return (p[pos] == ' ' || p[pos] == '\0') ? pos : wordEnd(p, pos + 1);
+    }
+
+    constexpr std::size_t skipSpaces(const char *p, std::size_t pos) {
+        return p[pos] == ' ' ? skipSpaces(p, pos + 1) : pos;
+    }
+
+    /** @return the position after the alternative that starts at pos in a word that ends at end */
+    constexpr std::size_t alternativeEnd(const char *p, std::size_t pos, std::size_t end) {
+        return (pos == end || p[pos] == '|') ? pos : alternativeEnd(p, pos + 1, end);
+    }
+
+    constexpr bool hasChar(const char *p, std::size_t pos, std::size_t end, char c) {
+        return pos != end && (p[pos] == c || hasChar(p, pos + 1, end, c));
+    }
+
+    constexpr bool equals(const char *p, std::size_t pos, std::size_t end, const char *s) {
+        return pos == end ? *s == '\0' : (p[pos] == *s && equals(p, pos + 1, end, s + 1));
+    }
+
+    enum class Word : std::uint8_t {
+        Multi,      // alternatives such as void|int|%num%
+        Optional,   // alternatives followed by |, the token is not consumed when there is no match
+        Not,        // !!else
+        Chars       // [;{}]
+    };
+
+    constexpr Word word(const char *p, std::size_t pos, std::size_t end) {
+        return (p[pos] == '!' && p[pos + 1] == '!' && p[pos + 2] != '\0') ? Word::Not :
+               (p[pos] == '[' && hasChar(p, pos, end, ']')) ? Word::Chars :
+               (p[end - 1] == '|') ? Word::Optional :
+               Word::Multi;
+    }
+
+    enum class Command : std::uint8_t {
+        None, Var, VarId, Type, Any, Assign, Name, Num, Char, Cop, Comp, Str, Bool, Op, Or, OrOr, Unknown
+    };
+
+    constexpr Command command(const char *p, std::size_t pos, std::size_t end) {
+        return (end - pos < 2 || p[pos] != '%') ? Command::None :
+               equals(p, pos, end, "%var%") ? Command::Var :
+               equals(p, pos, end, "%varid%") ? Command::VarId :
+               equals(p, pos, end, "%type%") ? Command::Type :
+               equals(p, pos, end, "%any%") ? Command::Any :
+               equals(p, pos, end, "%assign%") ? Command::Assign :
+               equals(p, pos, end, "%name%") ? Command::Name :
+               equals(p, pos, end, "%num%") ? Command::Num :
+               equals(p, pos, end, "%char%") ? Command::Char :
+               equals(p, pos, end, "%cop%") ? Command::Cop :
+               equals(p, pos, end, "%comp%") ? Command::Comp :
+               equals(p, pos, end, "%str%") ? Command::Str :
+               equals(p, pos, end, "%bool%") ? Command::Bool :
+               equals(p, pos, end, "%op%") ? Command::Op :
+               equals(p, pos, end, "%or%") ? Command::Or :
+               equals(p, pos, end, "%oror%") ? Command::OrOr :
+               Command::Unknown;
+    }
+
+    template<Command C>
+    struct CommandMatch;
+
+    template<>
+    struct CommandMatch<Command::Var> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->varId() != 0;
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::VarId> {
+        static bool match(const Token *tok, nonneg int varid) {
+            if (varid == 0)
+                throw InternalError(tok, "Internal error. Token::Match called with varid 0. Please report this to Cppcheck developers");
+            return tok->varId() == varid;
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Type> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->isName() && tok->varId() == 0;
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Any> {
+        static bool match(const Token * /*tok*/, nonneg int /*varid*/) {
+            return true;
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Assign> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->isAssignmentOp();
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Name> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->isName();
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Num> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->isNumber();
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Char> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->tokType() == Token::eChar;
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Cop> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->isConstOp();
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Comp> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->isComparisonOp();
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Str> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->tokType() == Token::eString;
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Bool> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->isBoolean();
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Op> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->isOp();
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::Or> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->tokType() == Token::eBitOp && tok->strId() == TokenStringIds::fixedId("|", 1);
+        }
+    };
+
+    template<>
+    struct CommandMatch<Command::OrOr> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return tok->tokType() == Token::eLogicalOp && tok->strId() == TokenStringIds::fixedId("||", 2);
+        }
+    };
+
+    /** compare the token string with the literal [Pos,End) of the pattern, by id if it has a fixed id */
+    template<class P, std::size_t Pos, std::size_t End, nonneg int Id = TokenStringIds::fixedId(P::value() + Pos, End - Pos)>
+    struct LiteralMatch {
+        static bool match(const Token *tok) {
+            return tok->strId() == Id;
+        }
+    };
+
+    template<class P, std::size_t Pos, std::size_t End>
+    struct LiteralMatch<P, Pos, End, 0> {
+        static bool match(const Token *tok) {
+            const std::string &str = tok->str();
+            return str.size() == End - Pos && std::memcmp(str.data(), P::value() + Pos, End - Pos) == 0;
+        }
+    };
+
+    template<class P, std::size_t Pos, std::size_t End, Command C = command(P::value(), Pos, End)>
+    struct AlternativeMatch {
+        static_assert(C != Command::Unknown, "Unknown command in Token::Match() pattern");
+
+        static bool match(const Token *tok, nonneg int varid) {
+            return CommandMatch<C>::match(tok, varid);
+        }
+    };
+
+    template<class P, std::size_t Pos, std::size_t End>
+    struct AlternativeMatch<P, Pos, End, Command::None> {
+        static bool match(const Token *tok, nonneg int /*varid*/) {
+            return LiteralMatch<P, Pos, End>::match(tok);
+        }
+    };
+
+    /** match the alternatives in [Pos,End) */
+    template<class P, std::size_t Pos, std::size_t End, bool Done = (Pos >= End)>
+    struct AlternativesMatch {
+        static bool match(const Token *tok, nonneg int varid) {
+            return AlternativeMatch<P, Pos, alternativeEnd(P::value(), Pos, End)>::match(tok, varid) ||
+                   AlternativesMatch<P, alternativeEnd(P::value(), Pos, End) + 1, End>::match(tok, varid);
+        }
+    };
+
+    template<class P, std::size_t Pos, std::size_t End>
+    struct AlternativesMatch<P, Pos, End, true> {
+        static bool match(const Token * /*tok*/, nonneg int /*varid*/) {
+            return false;
+        }
+    };
+
+    inline bool charsMatch(const char *chars, std::size_t len, char c)
+    {
+        int count = 0;
+        for (std::size_t i = 0; i < len; ++i) {
+            if (chars[i] == ']')
+                ++count;
+            else if (chars[i] == c)
+                return true;
+        }
+        return count > 1 && c == ']';
+    }
+
+    template<class P, std::size_t Pos, bool Done = (P::value()[skipSpaces(P::value(), Pos)] == '\0')>
+    struct WordsMatch;
+
+    /** match the word [Pos,End) and the words after it */
+    template<class P, std::size_t Pos, std::size_t End, Word W = word(P::value(), Pos, End)>
+    struct WordMatch {
+        static bool match(const Token *tok, nonneg int varid) {
+            return tok &&
+                   AlternativesMatch<P, Pos, End>::match(tok, varid) &&
+                   WordsMatch<P, End>::match(tok->next(), varid);
+        }
+    };
+
+    template<class P, std::size_t Pos, std::size_t End>
+    struct WordMatch<P, Pos, End, Word::Optional> {
+        static bool match(const Token *tok, nonneg int varid) {
+            if (!tok)
+                return false;
+            if (AlternativesMatch<P, Pos, End>::match(tok, varid))
+                return WordsMatch<P, End>::match(tok->next(), varid);
+            return WordsMatch<P, End>::match(tok, varid);
+        }
+    };
+
+    template<class P, std::size_t Pos, std::size_t End>
+    struct WordMatch<P, Pos, End, Word::Not> {
+        static bool match(const Token *tok, nonneg int varid) {
+            if (!tok)
+                return WordsMatch<P, End>::match(tok, varid);
+            return !LiteralMatch<P, Pos + 2, End>::match(tok) &&
+                   WordsMatch<P, End>::match(tok->next(), varid);
+        }
+    };
+
+    template<class P, std::size_t Pos, std::size_t End>
+    struct WordMatch<P, Pos, End, Word::Chars> {
+        static bool match(const Token *tok, nonneg int varid) {
+            return tok &&
+                   tok->str().size() == 1 &&
+                   charsMatch(P::value() + Pos + 1, End - Pos - 1, tok->str()[0]) &&
+                   WordsMatch<P, End>::match(tok->next(), varid);
+        }
+    };
+
+    template<class P, std::size_t Pos, bool Done>
+    struct WordsMatch {
+        static bool match(const Token *tok, nonneg int varid) {
+            return WordMatch<P, skipSpaces(P::value(), Pos), wordEnd(P::value(), skipSpaces(P::value(), Pos))>::match(tok, varid);
+        }
+    };
+
+    template<class P, std::size_t Pos>
+    struct WordsMatch<P, Pos, true> {
+        static bool match(const Token * /*tok*/, nonneg int /*varid*/) {
+            return true;
+        }
+    };
+
+    /** P::value() returns the pattern */
+    template<class P>
+    bool match(const Token *tok, nonneg int varid)
+    {
+        return WordsMatch<P, 0>::match(tok, varid);
+    }
+}
+
+/** Token::Match(tok, pattern) with a pattern that is compiled by the C++ compiler */
+#define TOKEN_MATCH(tok, pattern) TOKEN_MATCH_VARID(tok, pattern, 0)
+
+/** Token::Match(tok, pattern, varid) with a pattern that is compiled by the C++ compiler */
+#define TOKEN_MATCH_VARID(tok, pattern, varid) \
+    ([](const Token *matchTok, nonneg int matchVarId) { \
+        struct Pattern { \
+            static constexpr const char *value() { \
+                return pattern; \
+            } \
+        }; \
+        return TokenMatch::match<Pattern>(matchTok, matchVarId); \
+    }((tok), (varid)))
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // tokenmatchH
@@ -117,6 +117,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#ifdef HAS_THREADING_MODEL_THREAD
+#include <future>
+#endif
 #include <initializer_list>
 #include <iterator>
 #include <limits>
@@ -7259,6 +7262,9 @@ struct ValueFlowPass {
     virtual void run(const ValueFlowState& state) const = 0;
     // Returns true if pass needs C++
     virtual bool cpp() const = 0;
+    // Returns true if the pass only analyzes the function scopes that are not skipped, so independent
+    // function scopes can be analyzed in parallel
+    virtual bool parallel() const = 0;
     virtual ~ValueFlowPass() noexcept = default;
 };
 
@@ -7270,23 +7276,38 @@ struct ValueFlowPassRunner {
     {
         setSkippedFunctions();
         setStopTime();
+        setCallGraph();
+        this->state.tokenlist.setValueChangedScopes(&valueChangedScopes);
     }
 
-    bool run_once(std::initializer_list<ValuePtr<ValueFlowPass>> passes) const
+    ~ValueFlowPassRunner()
+    {
+        state.tokenlist.setValueChangedScopes(nullptr);
+    }
+
+    ValueFlowPassRunner(const ValueFlowPassRunner&) = delete;
+    ValueFlowPassRunner& operator=(const ValueFlowPassRunner&) = delete;
+
+    bool run_once(std::initializer_list<ValuePtr<ValueFlowPass>> passes)
     {
         return std::any_of(passes.begin(), passes.end(), [&](const ValuePtr<ValueFlowPass>& pass) {
-            return run(pass);
+            return run(pass, 0, nullptr);
         });
     }
 
-    bool run(std::initializer_list<ValuePtr<ValueFlowPass>> passes) const
+    bool run(std::initializer_list<ValuePtr<ValueFlowPass>> passes)
     {
         std::size_t values = 0;
         std::size_t n = state.settings.vfOptions.maxIterations;
+        std::size_t iteration = 0;
+        // the pass run when the pass was executed the last time
+        std::vector<std::size_t> lastRuns(passes.size(), 0);
         while (n > 0 && values != getTotalValues()) {
             values = getTotalValues();
+            ++iteration;
+            auto lastRun = lastRuns.begin();
             if (std::any_of(passes.begin(), passes.end(), [&](const ValuePtr<ValueFlowPass>& pass) {
-                return run(pass);
+                return run(pass, iteration, &*lastRun++);
             }))
                 return true;
             --n;
@@ -7306,7 +7327,8 @@ struct ValueFlowPassRunner {
         return false;
     }
 
-    bool run(const ValuePtr<ValueFlowPass>& pass) const
+    // iteration is 0 for passes that are only run once
+    bool run(const ValuePtr<ValueFlowPass>& pass, std::size_t iteration, std::size_t* lastRun)
     {
         auto start = Clock::now();
         if (start > stop) {
@@ -7315,21 +7337,237 @@ struct ValueFlowPassRunner {
         }
         if (!state.tokenlist.isCPP() && pass->cpp())
             return false;
+
+        updateChangedScopes();
+        ++passRuns;
+        ValueFlowState passState = state;
+        if (lastRun) {
+            if (*lastRun > 0)
+                skipUnchangedFunctions(passState, *lastRun);
+            *lastRun = passRuns;
+        }
+
         if (timerResults) {
-            Timer t(pass->name(), state.settings.showtime, timerResults);
-            pass->run(state);
+            const std::size_t addedValues = state.tokenlist.getAddedValueCount();
+            {
+                Timer t(pass->name(), state.settings.showtime, timerResults);
+                runPass(pass, passState);
+            }
+            if (state.settings.showtime != SHOWTIME_MODES::SHOWTIME_NONE) {
+                std::string str = pass->name();
+                str += " - added values";
+                if (iteration > 0)
+                    str += " (iteration " + std::to_string(iteration) + ")";
+                timerResults->addCount(str, state.tokenlist.getAddedValueCount() - addedValues);
+            }
         } else {
-            pass->run(state);
+            runPass(pass, passState);
         }
         return false;
     }
 
+    void runPass(const ValuePtr<ValueFlowPass>& pass, const ValueFlowState& passState)
+    {
+#ifdef HAS_THREADING_MODEL_THREAD
+        if (pass->parallel() && state.settings.vfOptions.jobs > 1 && runParallel(pass, passState))
+            return;
+#endif
+        pass->run(passState);
+    }
+
+#ifdef HAS_THREADING_MODEL_THREAD
+    /**
+     * Function scopes that call each other or that are nested are analyzed by the same thread. A thread
+     * only changes the values of the tokens in its own function scopes, the other values are set when
+     * all threads are done.
+     */
+    bool runParallel(const ValuePtr<ValueFlowPass>& pass, const ValueFlowState& passState)
+    {
+        std::vector<std::set<const Scope*>> buckets = getFunctionScopeBuckets(passState);
+        if (buckets.size() < 2)
+            return false;
+
+        struct Worker {
+            ValueFlow::TokenValueBoundary boundary;
+            BufferedErrorLogger errorLogger;
+            std::future<void> done;
+        };
+        std::vector<Worker> workers(buckets.size());
+
+        const std::size_t addedValues = state.tokenlist.getAddedValueCount();
+        // the changes can not be recorded by several threads
+        state.tokenlist.setValueChangedScopes(nullptr);
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            Worker& worker = workers[i];
+            worker.boundary.functionScopes = std::move(buckets[i]);
+            ValueFlowState workerState{passState.tokenlist, passState.symboldatabase, worker.errorLogger, passState.settings};
+            workerState.skippedFunctions = passState.skippedFunctions;
+            for (const Scope* functionScope : state.symboldatabase.functionScopes) {
+                if (worker.boundary.functionScopes.count(functionScope) == 0)
+                    workerState.skippedFunctions.emplace(functionScope);
+            }
+            worker.done = std::async(std::launch::async, [&pass, &worker](const ValueFlowState& s) {
+                ValueFlow::setTokenValueBoundary(&worker.boundary);
+                try {
+                    pass->run(s);
+                } catch (...) {
+                    ValueFlow::setTokenValueBoundary(nullptr);
+                    throw;
+                }
+                ValueFlow::setTokenValueBoundary(nullptr);
+            }, std::move(workerState));
+        }
+        for (Worker& worker : workers)
+            worker.done.wait();
+        state.tokenlist.setValueChangedScopes(&valueChangedScopes);
+
+        for (Worker& worker : workers) {
+            worker.done.get();
+            worker.errorLogger.forward(state.errorLogger);
+        }
+
+        if (state.tokenlist.getAddedValueCount() != addedValues) {
+            for (const Worker& worker : workers) {
+                for (const Scope* functionScope : worker.boundary.functionScopes)
+                    markFunctionChanged(functionScope);
+            }
+        }
+
+        // the values of the tokens outside of the boundaries are recorded as usual
+        for (Worker& worker : workers)
+            ValueFlow::setDeferredTokenValues(worker.boundary, state.settings);
+        return true;
+    }
+
+    // the function scopes of a bucket are analyzed by one thread
+    std::vector<std::set<const Scope*>> getFunctionScopeBuckets(const ValueFlowState& passState) const
+    {
+        const std::vector<const Scope*>& functionScopes = state.symboldatabase.functionScopes;
+
+        std::unordered_map<const Scope*, const Scope*> parent;
+        std::function<const Scope*(const Scope*)> find = [&](const Scope* scope) {
+            const auto it = parent.find(scope);
+            if (it == parent.end() || it->second == scope)
+                return scope;
+            return it->second = find(it->second);
+        };
+        auto unite = [&](const Scope* scope1, const Scope* scope2) {
+            const Scope* root1 = find(scope1);
+            const Scope* root2 = find(scope2);
+            if (root1 != root2)
+                parent[root2] = root1;
+        };
+        for (const Scope* functionScope : functionScopes) {
+            for (const Scope* s = getFunctionScope(functionScope->nestedIn); s; s = getFunctionScope(s->nestedIn))
+                unite(s, functionScope);
+            const auto it = callGraph.find(functionScope);
+            if (it == callGraph.end())
+                continue;
+            for (const Scope* s : it->second)
+                unite(functionScope, s);
+        }
+
+        struct Component {
+            std::vector<const Scope*> scopes;
+            std::size_t size{};
+            bool active{};
+        };
+        std::vector<Component> components;
+        std::unordered_map<const Scope*, std::size_t> componentIndex;
+        for (const Scope* functionScope : functionScopes) {
+            const auto it = componentIndex.emplace(find(functionScope), components.size()).first;
+            if (it->second == components.size())
+                components.emplace_back();
+            Component& component = components[it->second];
+            component.scopes.push_back(functionScope);
+            if (passState.skippedFunctions.count(functionScope) == 0) {
+                component.active = true;
+                const auto sizeIt = scopeSize.find(functionScope);
+                if (sizeIt != scopeSize.end())
+                    component.size += sizeIt->second;
+            }
+        }
+        components.erase(std::remove_if(components.begin(), components.end(), [](const Component& c) {
+            return !c.active;
+        }), components.end());
+        std::stable_sort(components.begin(), components.end(), [](const Component& c1, const Component& c2) {
+            return c1.size > c2.size;
+        });
+
+        const std::size_t n = std::min<std::size_t>(state.settings.vfOptions.jobs, components.size());
+        std::vector<std::set<const Scope*>> buckets(n);
+        std::vector<std::size_t> bucketSize(n, 0);
+        for (const Component& component : components) {
+            const std::size_t i = std::min_element(bucketSize.cbegin(), bucketSize.cend()) - bucketSize.cbegin();
+            buckets[i].insert(component.scopes.cbegin(), component.scopes.cend());
+            bucketSize[i] += component.size;
+        }
+        return buckets;
+    }
+#endif
+
+    // the values are counted by the tokens so this does not need to walk the token list
     std::size_t getTotalValues() const
     {
-        std::size_t n = 1;
-        for (Token* tok = state.tokenlist.front(); tok; tok = tok->next())
-            n += tok->values().size();
-        return n;
+        return state.tokenlist.getValueCount() + 1;
+    }
+
+    /**
+     * Passes that iterate over the function scopes do not need to analyze a function again when
+     * neither the function, its callers and callees nor anything outside of the functions was
+     * changed since the pass was run the last time.
+     */
+    void skipUnchangedFunctions(ValueFlowState& passState, std::size_t lastRun) const
+    {
+        if (globalChanged >= lastRun)
+            return;
+        for (const Scope* functionScope : state.symboldatabase.functionScopes) {
+            const auto it = scopeChanged.find(functionScope);
+            if (it == scopeChanged.end() || it->second < lastRun)
+                passState.skippedFunctions.emplace(functionScope);
+        }
+    }
+
+    // the changes recorded by the tokens were made by the last pass run
+    void updateChangedScopes()
+    {
+        for (const Scope* scope : valueChangedScopes) {
+            const Scope* functionScope = getFunctionScope(scope);
+            if (!functionScope) {
+                globalChanged = passRuns;
+                continue;
+            }
+            markFunctionChanged(functionScope);
+        }
+        valueChangedScopes.clear();
+    }
+
+    void markFunctionChanged(const Scope* functionScope)
+    {
+        // a local class is analyzed along with the enclosing function
+        for (; functionScope; functionScope = getFunctionScope(functionScope->nestedIn)) {
+            scopeChanged[functionScope] = passRuns;
+            const auto it = callGraph.find(functionScope);
+            if (it == callGraph.end())
+                continue;
+            for (const Scope* s : it->second)
+                scopeChanged[s] = passRuns;
+        }
+    }
+
+    void setCallGraph()
+    {
+        for (const Scope* functionScope : state.symboldatabase.functionScopes) {
+            std::size_t& size = scopeSize[functionScope];
+            for (const Token* tok = functionScope->bodyStart; tok != functionScope->bodyEnd; tok = tok->next()) {
+                ++size;
+                const Function* function = tok->function();
+                if (!function || !function->functionScope || function->functionScope == functionScope)
+                    continue;
+                callGraph[functionScope].emplace(function->functionScope);
+                callGraph[function->functionScope].emplace(functionScope);
+            }
+        }
     }
 
     void setSkippedFunctions()
@@ -7378,14 +7616,27 @@ struct ValueFlowPassRunner {
     ValueFlowState state;
     TimePoint stop;
     TimerResultsIntf* timerResults;
+
+    // function scopes that call each other
+    std::unordered_map<const Scope*, std::set<const Scope*>> callGraph;
+    // number of tokens in the function scope
+    std::unordered_map<const Scope*, std::size_t> scopeSize;
+    // scopes of the tokens whose values were changed by the last pass run
+    std::vector<const Scope*> valueChangedScopes;
+    // the pass run that changed the values in the function scope the last time
+    std::unordered_map<const Scope*, std::size_t> scopeChanged;
+    // the pass run that changed values outside of the function scopes the last time
+    std::size_t globalChanged{};
+    std::size_t passRuns{};
 };
 
 template<class F>
 struct ValueFlowPassAdaptor : ValueFlowPass {
     const char* mName = nullptr;
     bool mCPP = false;
+    bool mParallel = false;
     F mRun;
-    ValueFlowPassAdaptor(const char* pname, bool pcpp, F prun) : ValueFlowPass(), mName(pname), mCPP(pcpp), mRun(prun) {}
+    ValueFlowPassAdaptor(const char* pname, bool pcpp, bool pparallel, F prun) : ValueFlowPass(), mName(pname), mCPP(pcpp), mParallel(pparallel), mRun(prun) {}
     const char* name() const override {
         return mName;
     }
@@ -7396,17 +7647,21 @@ struct ValueFlowPassAdaptor : ValueFlowPass {
     bool cpp() const override {
         return mCPP;
     }
+    bool parallel() const override {
+        return mParallel;
+    }
 };
 
 template<class F>
-static ValueFlowPassAdaptor<F> makeValueFlowPassAdaptor(const char* name, bool cpp, F run)
+static ValueFlowPassAdaptor<F> makeValueFlowPassAdaptor(const char* name, bool cpp, bool parallel, F run)
 {
-    return {name, cpp, run};
+    return {name, cpp, parallel, run};
 }
 
-#define VALUEFLOW_ADAPTOR(cpp, ...)                                                                                    \
+#define VALUEFLOW_ADAPTOR(cpp, parallel, ...)                                                                          \
     makeValueFlowPassAdaptor(#__VA_ARGS__,                                                                             \
                              (cpp),                                                                                      \
+                             (parallel),                                                                                 \
                              [](TokenList& tokenlist,                                                                  \
                                 SymbolDatabase& symboldatabase,                                                        \
                                 ErrorLogger& errorLogger,                                                              \
@@ -7420,8 +7675,11 @@ static ValueFlowPassAdaptor<F> makeValueFlowPassAdaptor(const char* name, bool c
         __VA_ARGS__;                                                                          \
     })
 
-#define VFA(...) VALUEFLOW_ADAPTOR(false, __VA_ARGS__)
-#define VFA_CPP(...) VALUEFLOW_ADAPTOR(true, __VA_ARGS__)
+#define VFA(...) VALUEFLOW_ADAPTOR(false, false, __VA_ARGS__)
+#define VFA_CPP(...) VALUEFLOW_ADAPTOR(true, false, __VA_ARGS__)
+// passes that only analyze the function scopes that are not skipped
+#define VFA_PARALLEL(...) VALUEFLOW_ADAPTOR(false, true, __VA_ARGS__)
+#define VFA_CPP_PARALLEL(...) VALUEFLOW_ADAPTOR(true, true, __VA_ARGS__)
 
 void ValueFlow::setValues(TokenList& tokenlist,
                           SymbolDatabase& symboldatabase,
@@ -7466,16 +7724,16 @@ void ValueFlow::setValues(TokenList& tokenlist,
     runner.run({
         VFA(valueFlowImpossibleValues(tokenlist, settings)),
         VFA(valueFlowSymbolicOperators(symboldatabase, settings)),
-        VFA(valueFlowCondition(SymbolicConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
+        VFA_PARALLEL(valueFlowCondition(SymbolicConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
         VFA(valueFlowSymbolicInfer(symboldatabase, settings)),
         VFA(valueFlowArrayBool(tokenlist, settings)),
         VFA(valueFlowArrayElement(tokenlist, settings)),
         VFA(valueFlowRightShift(tokenlist, settings)),
-        VFA_CPP(
+        VFA_CPP_PARALLEL(
             valueFlowCondition(ContainerConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
-        VFA(valueFlowAfterAssign(tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
+        VFA_PARALLEL(valueFlowAfterAssign(tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
         VFA_CPP(valueFlowAfterSwap(tokenlist, symboldatabase, errorLogger, settings)),
-        VFA(valueFlowCondition(SimpleConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
+        VFA_PARALLEL(valueFlowCondition(SimpleConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
         VFA(valueFlowInferCondition(tokenlist, settings)),
         VFA(valueFlowSwitchVariable(tokenlist, symboldatabase, errorLogger, settings)),
         VFA(valueFlowForLoop(tokenlist, symboldatabase, errorLogger, settings)),
@@ -7487,7 +7745,7 @@ void ValueFlow::setValues(TokenList& tokenlist,
         VFA_CPP(valueFlowAfterMove(tokenlist, symboldatabase, errorLogger, settings)),
         VFA_CPP(valueFlowSmartPointer(tokenlist, errorLogger, settings)),
         VFA_CPP(valueFlowIterators(tokenlist, settings)),
-        VFA_CPP(
+        VFA_CPP_PARALLEL(
             valueFlowCondition(IteratorConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
         VFA_CPP(valueFlowIteratorInfer(tokenlist, settings)),
         VFA_CPP(valueFlowContainerSize(tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
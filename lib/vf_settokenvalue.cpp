@@ -217,12 +217,44 @@ namespace ValueFlow
         return false;
     }
 
+    static thread_local TokenValueBoundary* tokenValueBoundary = nullptr;
+
+    void setTokenValueBoundary(TokenValueBoundary* boundary)
+    {
+        tokenValueBoundary = boundary;
+    }
+
+    static bool isInsideBoundary(const Token* tok, const TokenValueBoundary& boundary)
+    {
+        // temporary tokens that are not part of the token list are only used by the current thread
+        if (!tok->scope())
+            return true;
+        for (const Scope* scope = tok->scope(); scope; scope = scope->nestedIn) {
+            if (scope->type == ScopeType::eFunction && boundary.functionScopes.count(scope) > 0)
+                return true;
+        }
+        return false;
+    }
+
+    void setDeferredTokenValues(TokenValueBoundary& boundary, const Settings& settings)
+    {
+        std::vector<TokenValueBoundary::DeferredValue> deferred;
+        deferred.swap(boundary.deferred);
+        for (TokenValueBoundary::DeferredValue& d : deferred)
+            setTokenValue(d.tok, std::move(d.value), settings, d.loc);
+    }
+
     /** set ValueFlow value and perform calculations if possible */
     void setTokenValue(Token* tok,
                        Value value,
                        const Settings& settings,
                        SourceLocation loc)
     {
+        if (tokenValueBoundary && !isInsideBoundary(tok, *tokenValueBoundary)) {
+            tokenValueBoundary->deferred.push_back({tok, std::move(value), loc});
+            return;
+        }
+
         // Skip setting values that are too big since its ambiguous
         if (!value.isImpossible() && value.isIntValue() && value.intvalue < 0 && astIsUnsigned(tok) &&
             getSizeOf(*tok->valueType(), settings) >= sizeof(MathLib::bigint))
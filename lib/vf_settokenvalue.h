@@ -20,10 +20,14 @@
 #define vfSetTokenValueH
 
 #include "sourcelocation.h"
+#include "vfvalue.h"
 
+#include <set>
+#include <vector>
+
+class Scope;
 class Token;
 class Settings;
-namespace ValueFlow { class Value; }
 
 namespace ValueFlow
 {
@@ -31,6 +35,27 @@ namespace ValueFlow
                        Value value,
                        const Settings& settings,
                        SourceLocation loc = SourceLocation::current());
+
+    /**
+     * Mutation boundary for analyzing function scopes in parallel. While it is set for a thread,
+     * setTokenValue() only changes tokens in the bodies of the given function scopes. The values of
+     * all other tokens are collected and are set by setDeferredTokenValues() when the threads are done.
+     */
+    struct TokenValueBoundary {
+        struct DeferredValue {
+            Token* tok;
+            Value value;
+            SourceLocation loc;
+        };
+
+        std::set<const Scope*> functionScopes;
+        std::vector<DeferredValue> deferred;
+    };
+
+    /** Set the mutation boundary of the current thread, nullptr removes it */
+    void setTokenValueBoundary(TokenValueBoundary* boundary);
+
+    void setDeferredTokenValues(TokenValueBoundary& boundary, const Settings& settings);
 }
 
 #endif // vfSetTokenValueH
@@ -3,6 +3,7 @@
 import json
 import os
 import pathlib
+import re
 
 from testutils import cppcheck
 import xml.etree.ElementTree as ET
@@ -119,3 +120,54 @@ def test_duplicate_file_entries(tmpdir):  #13333
     assert os.path.isfile(test_file + '.dump')
     assert os.path.isfile(test_file + '.1.dump')
 
+
+
+def __elements(events):
+    # the ids are addresses and the order of some lists depends on them
+    def normalize(value):
+        return 'id' if re.match(r'^(0x)?[0-9a-f]{8,16}$', value) else value
+    return sorted((event, node.tag, sorted((k, normalize(v)) for k, v in node.attrib.items())) for event, node in events)
+
+
+def test_binary(tmp_path):
+    import sys
+    sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', '..', 'addons'))
+    import cppcheckdata
+
+    test_file = tmp_path / 'test.cpp'
+    with open(test_file, 'wt') as f:
+        f.write("""
+#define N 10
+#ifdef A
+int a;
+#endif
+struct S { int x; S() : x(0) {} };
+const char *s = "<&\\">'\\t";
+int f(int i) {
+    int buf[N] = {0};
+    return i < N ? buf[i] : -1;
+}
+""")
+
+    args = ['--dump', '--library=posix', str(test_file)]
+    exitcode, stdout, stderr = cppcheck(args)
+    assert exitcode == 0, stdout if stdout else stderr
+    dump_file = str(test_file) + '.dump'
+    xml_elements = __elements(ET.iterparse(dump_file, events=('start', 'end')))
+    xml_tokens = [(tok.str, tok.linenr, tok.column) for cfg in cppcheckdata.CppcheckData(dump_file).iterconfigurations() for tok in cfg.tokenlist]
+
+    exitcode, stdout, stderr = cppcheck(['--dump-format=binary'] + args)
+    assert exitcode == 0, stdout if stdout else stderr
+    with open(dump_file, 'rb') as f:
+        assert f.read(12) == b'CPPCHECKDUMP'
+    assert __elements(cppcheckdata.iterparse(dump_file)) == xml_elements
+    assert len(xml_elements) > 100
+
+    data = cppcheckdata.CppcheckData(dump_file)
+    assert [(tok.str, tok.linenr, tok.column) for cfg in data.iterconfigurations() for tok in cfg.tokenlist] == xml_tokens
+    assert data.language == 'cpp'
+    assert len(data.rawTokens) > 0
+    cfgs = data.configurations
+    assert [cfg.name for cfg in cfgs] == ['', 'A']
+    assert any(tok.str == '"<&\\">\'\\t"' for tok in cfgs[0].tokenlist)
+    assert sorted(f.name for f in cfgs[0].functions) == ['S', 'f']
@@ -807,6 +807,136 @@ Exceptio [internalError]
     assert stderr.endswith('raise Exception()\nException [internalError]\n\n^\n')
 
 
+def __test_addon_server(tmpdir, extra_args):
+    addon_file = os.path.join(tmpdir, 'addon1.py')
+    with open(addon_file, 'wt') as f:
+        f.write("""
+import cppcheckdata
+import os
+import sys
+
+# report the id of the process that checked the file
+for arg in sys.argv[1:]:
+    if arg.endswith('.dump'):
+        data = cppcheckdata.CppcheckData(arg)
+        for cfg in data.iterconfigurations():
+            cppcheckdata.reportError(cfg.tokenlist[0], 'style', str(os.getpid()), 'addon1', 'pid')
+                """)
+
+    test_files = []
+    for i in range(3):
+        test_file = os.path.join(tmpdir, 'file{}.cpp'.format(i))
+        with open(test_file, 'wt') as f:
+            f.write('int x;\n')
+        test_files.append(test_file)
+
+    args = ['--addon={}'.format(addon_file), '--enable=style', '--template={file}:{message}', '-q'] + extra_args + test_files
+
+    exitcode, stdout, stderr = cppcheck(args)
+    assert exitcode == 0, stdout if stdout else stderr
+    assert stdout == ''
+    lines = sorted(stderr.splitlines())
+    assert [line.split(':')[0] for line in lines] == test_files
+    return set(line.split(':')[1] for line in lines)
+
+
+def test_addon_server(tmpdir):
+    assert len(__test_addon_server(tmpdir, ['-j1'])) == 3
+    assert len(__test_addon_server(tmpdir, ['--addon-server', '-j1'])) == 1
+
+
+def test_addon_server_j2(tmpdir):
+    assert len(__test_addon_server(tmpdir, ['--addon-server', '-j2', '--executor=thread'])) <= 2
+
+
+def test_addon_server_process_pool(tmpdir):
+    assert len(__test_addon_server(tmpdir, ['--addon-server', '-j2', '--executor=process'])) == 3
+    # the children of the pool check several files and keep their addon workers
+    assert len(__test_addon_server(tmpdir, ['--addon-server', '-j2', '--executor=process', '--process-pool'])) <= 2
+
+
+@pytest.mark.skipif(not sys.platform.startswith('linux'), reason='requires /proc')
+def test_process_pool_crash(tmpdir):
+    addon_file = os.path.join(tmpdir, 'addon1.py')
+    with open(addon_file, 'wt') as f:
+        f.write("""
+import os
+import signal
+import sys
+
+# kill the cppcheck process that checks crash.cpp
+if any(os.path.basename(arg).startswith('crash.cpp') for arg in sys.argv[1:]):
+    pid = os.getppid()
+    while pid > 1:
+        with open('/proc/{}/stat'.format(pid), 'rt') as f:
+            stat = f.read()
+        if stat[stat.find('(') + 1:stat.rfind(')')] == 'cppcheck':
+            os.kill(pid, signal.SIGKILL)
+            break
+        pid = int(stat[stat.rfind(')') + 2:].split()[1])
+                """)
+
+    test_files = []
+    for name in ('crash.cpp', 'file0.cpp', 'file1.cpp', 'file2.cpp', 'file3.cpp'):
+        test_file = os.path.join(tmpdir, name)
+        with open(test_file, 'wt') as f:
+            f.write('void f() { (void)*((int*)0); }\n')
+        test_files.append(test_file)
+
+    args = ['--addon={}'.format(addon_file), '--template={file}:{id}:{message}', '-j2', '--executor=process', '--process-pool'] + test_files
+
+    exitcode, stdout, stderr = cppcheck(args)
+    assert exitcode == 0, stdout if stdout else stderr
+    # the files that are checked after the crash are still checked
+    assert stdout.count('files checked') == 5
+    lines = sorted(stderr.splitlines())
+    assert lines == [
+        '{}:cppcheckError:Internal error: Child process crashed with signal 9'.format(test_files[0])
+    ] + ['{}:nullPointer:Null pointer dereference: (int*)0'.format(f) for f in test_files[1:]]
+
+
+def test_addon_server_misra(tmpdir):
+    test_file = os.path.join(tmpdir, 'test.cpp')
+    with open(test_file, 'wt') as f:
+        f.write("""
+typedef int MISRA_5_6_VIOLATION;
+        """)
+
+    args = ['--addon=misra', '--addon-server', '--enable=all', '--disable=unusedFunction', '-j1', test_file]
+
+    exitcode, stdout, stderr = cppcheck(args)
+    assert exitcode == 0, stdout if stdout else stderr
+    assert stdout.splitlines() == [
+        'Checking {} ...'.format(test_file)
+    ]
+    assert stderr == '{}:2:1: style: misra violation (use --rule-texts=<file> to get proper output) [misra-c2012-2.3]\ntypedef int MISRA_5_6_VIOLATION;\n^\n'.format(test_file)
+
+
+def test_addon_server_invalid_addon_py(tmpdir):
+    addon_file = os.path.join(tmpdir, 'addon1.py')
+    with open(addon_file, 'wt') as f:
+        f.write("""
+raise Exception()
+                """)
+
+    test_file = os.path.join(tmpdir, 'file.cpp')
+    with open(test_file, 'wt') as f:
+        f.write("""
+typedef int MISRA_5_6_VIOLATION;
+                """)
+
+    args = ['--addon={}'.format(addon_file), '--addon-server', '--enable=all', '--disable=unusedFunction', '--verbose', '-j1', test_file]
+
+    exitcode, stdout, stderr = cppcheck(args)
+    assert exitcode == 0  # TODO: needs to be 1
+    assert __remove_verbose_log(stdout.splitlines()) == [
+        'Checking {} ...'.format(test_file)
+    ]
+    assert stderr.startswith("{}:0:0: error: Bailing out from analysis: Checking file failed: Failed to execute addon 'addon1' - exitcode is 1: ".format(test_file))
+    assert stderr.count('Output:\nTraceback')
+    assert stderr.endswith('raise Exception()\nException [internalError]\n\n^\n')
+
+
 def test_addon_result(tmpdir):
     addon_file = os.path.join(tmpdir, 'addon1.py')
     with open(addon_file, 'wt') as f:
@@ -900,6 +1030,54 @@ def test_showtime_top5_file(tmpdir):
     assert stderr == ''
 
 
+def test_report_slow_checks(tmpdir):
+    test_file = os.path.join(tmpdir, 'test.cpp')
+    with open(test_file, 'wt') as f:
+        f.write("""
+                int main(int argc)
+                {
+                }
+                """)
+
+    args = ['--report-slow-checks=3', '--quiet', test_file]
+
+    exitcode, stdout, stderr = cppcheck(args)
+    assert exitcode == 0
+    lines = stdout.splitlines()
+    assert len(lines) == 5
+    assert lines[0] == ''
+    assert lines[1] == 'Slowest checks:'
+    for i in range(2, 5):
+        assert lines[i].startswith('{}: '.format(test_file))
+        assert lines[i].endswith('s')
+    assert stderr == ''
+
+
+def test_checks_max_time_check(tmpdir):
+    test_file = os.path.join(tmpdir, 'test.cpp')
+    with open(test_file, 'wt') as f:
+        f.write("""
+                #ifdef A
+                int x;
+                #endif
+                void f()
+                {
+                    int a[10];
+                    a[10] = 0;
+                }
+                """)
+
+    # the check is skipped in the second configuration since the time is exceeded in the first one
+    args = ['--checks-max-time=Bounds checking:0', '--debug-warnings', '--template=simple', '--quiet', test_file]
+
+    exitcode, stdout, stderr = cppcheck(args)
+    assert exitcode == 0, stdout
+    assert stdout == ''
+    lines = stderr.splitlines()
+    assert '{}:8:22: error: Array \'a[10]\' accessed at index 10, which is out of bounds. [arrayIndexOutOfBounds]'.format(test_file) in lines
+    assert '{}:0:0: debug: Check \'Bounds checking\' maximum time exceeded [checkMaxTime]'.format(test_file) in lines
+
+
 def test_missing_addon(tmpdir):
     args = ['--addon=misra3', '--addon=misra', '--addon=misra2', 'file.c']
 
@@ -2365,6 +2543,7 @@ void f(bool b)
         '--enable=warning',  # to execute the code which generates the normalCheckLevelMaxBranches message
         '--enable=information',  # to show the normalCheckLevelMaxBranches message
         '--cppcheck-build-dir={}'.format(build_dir),
+        '--analyzer-info-format=xml',
         '--template=simple',
         str(test_file)
     ]
@@ -3,6 +3,7 @@
 
 import os
 import sys
+import time
 
 import pytest
 
@@ -240,3 +241,27 @@ def test_crash_array_in_namespace(tmpdir):
                     };
                 }""")
     cppcheck([filename]) # should not take more than ~5 seconds
+
+
+@pytest.mark.skipif(sys.platform == 'win32', reason='the process executor is not available on Windows')
+@pytest.mark.parametrize("executor", ['process', 'thread'])
+@pytest.mark.timeout(120)
+def test_many_messages(tmpdir, executor):
+    # measures the throughput of the results that are passed from the workers
+    files = []
+    for i in range(4):
+        filename = os.path.join(tmpdir, 'test{}.c'.format(i))
+        with open(filename, 'wt') as f:
+            for j in range(2500):
+                f.write('void f{}(void) {{ int *p = 0; *p = 1; }}\n'.format(j))
+        files.append(filename)
+
+    args = ['-q', '-j2', '--executor={}'.format(executor), '--template={file}:{line}:{id}'] + files
+    start = time.perf_counter()
+    exitcode, stdout, stderr = cppcheck(args)
+    elapsed = time.perf_counter() - start
+    assert exitcode == 0, stdout if stdout else stderr
+    lines = stderr.splitlines()
+    assert len(lines) == 10000
+    assert len(set(lines)) == 10000
+    print('{} executor: {} messages in {:.2f}s ({:.0f} messages/s)'.format(executor, len(lines), elapsed, len(lines) / elapsed))
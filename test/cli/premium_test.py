@@ -81,7 +81,7 @@ def test_build_dir_hash_cppcheck_product(tmpdir):
         f.write(';')
 
     build_dir = tmpdir.mkdir('b')
-    args = [f'--cppcheck-build-dir={build_dir}', test_file]
+    args = [f'--cppcheck-build-dir={build_dir}', '--analyzer-info-format=xml', test_file]
 
     exitcode, stdout, stderr = cppcheck(args)
     assert 'error' not in stdout
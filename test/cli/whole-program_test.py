@@ -410,3 +410,28 @@ def test_nullpointer_out_of_memory(tmpdir, single_file):
     else:
         # the bug is found using ctu analysis
         assert results == ['[ctunullpointerOutOfMemory]']
+
+
+def test_checks_order_builddir_j(tmpdir):
+    # the checks are run in parallel in the whole program analysis, the results are reported in the order of the checks
+    args = [
+        '-q',
+        '--template=simple',
+        '--enable=information,style',
+        'whole-program/nullpointer1.cpp',
+        'whole-program/odr1.cpp',
+        'whole-program/odr2.cpp'
+    ]
+
+    def __ctu_results(extra_args):
+        _, _, stderr = cppcheck(args + extra_args, cwd=__script_dir)
+        return [line for line in stderr.splitlines() if '[ctu' in line]
+
+    build_dir_1 = os.path.join(tmpdir, 'b1')
+    os.mkdir(build_dir_1)
+    results_1 = __ctu_results(['-j1', '--cppcheck-build-dir={}'.format(build_dir_1)])
+    assert len(results_1) == 2, results_1
+
+    build_dir_2 = os.path.join(tmpdir, 'b2')
+    os.mkdir(build_dir_2)
+    assert __ctu_results(['-j2', '--cppcheck-build-dir={}'.format(build_dir_2)]) == results_1
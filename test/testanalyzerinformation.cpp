@@ -18,10 +18,23 @@
 
 
 #include "analyzerinfo.h"
+#include "errorlogger.h"
+#include "errortypes.h"
 #include "filesettings.h"
 #include "fixture.h"
-
+#include "helpers.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <set>
 #include <sstream>
+#include <string>
+
+#include "xml.h"
 
 class TestAnalyzerInformation : public TestFixture, private AnalyzerInformation {
 public:
@@ -34,6 +47,9 @@ private:
         TEST_CASE(duplicateFile);
         TEST_CASE(filesTextDuplicateFile);
         TEST_CASE(parse);
+        TEST_CASE(fileTimes);
+        TEST_CASE(binaryFormat);
+        TEST_CASE(xmlFormat);
     }
 
     void getAnalyzerInfoFile() const {
@@ -95,6 +111,111 @@ private:
         ASSERT_EQUALS(0, info.fileIndex);
         ASSERT_EQUALS("C:/dm/cppcheck-fix-13333/test/cli/whole-program/odr1.cpp", info.sourceFile);
     }
+
+    void fileTimes() const {
+        ASSERT_EQUALS("::file1.c", getFileTimesKey("./file1.c", "", 0));
+        ASSERT_EQUALS("A=1:2:file1.c", getFileTimesKey("file1.c", "A=1", 2));
+
+        constexpr char fileTimesTxt[] = "120:::file1.c\n"
+                                        "7:A=1:2:C:/dir/file2.c\n"
+                                        "x:::file3.c\n"
+                                        ":::file4.c\n";
+        std::istringstream f(fileTimesTxt);
+        const std::map<std::string, std::size_t> times = parseFileTimes(f);
+        ASSERT_EQUALS(2U, times.size());
+        ASSERT_EQUALS(120U, times.at("::file1.c"));
+        ASSERT_EQUALS(7U, times.at("A=1:2:C:/dir/file2.c"));
+    }
+
+    void writeAndRead(bool xml) const {
+        const std::string buildDir = xml ? "analyzerinfo-xml" : "analyzerinfo-binary";
+        const ScopedFile dummy("dummy", "", buildDir);
+        const std::string analyzerInfoFile = AnalyzerInformation::getAnalyzerInfoFile(buildDir, "a.c", "", 0);
+
+        const ErrorMessage errmsg({ErrorMessage::FileLocation("a.c", 3, 1)}, "a.c", Severity::error, "Null pointer dereference", "nullPointer", Certainty::normal);
+        {
+            std::list<ErrorMessage> errors;
+            AnalyzerInformation info(xml);
+            ASSERT(info.analyzeFile(buildDir, "a.c", "", 0, 123, errors));
+            info.reportErr(errmsg);
+            info.setFileInfo("ctu", "<function-call id=\"1\"/>\n");
+            info.setFileInfo("CheckUnusedFunctions", "<functiondecl functionName=\"f\"/>\n");
+            info.close();
+        }
+
+        {
+            std::ifstream fin(analyzerInfoFile, std::ios::binary);
+            ASSERT_EQUALS(xml, fin.get() == '<');
+        }
+
+        // the errors are restored when the hash is unchanged
+        {
+            std::list<ErrorMessage> errors;
+            AnalyzerInformation info(xml);
+            ASSERT(!info.analyzeFile(buildDir, "a.c", "", 0, 123, errors));
+            ASSERT_EQUALS(1U, errors.size());
+            ASSERT_EQUALS(errmsg.toXML(), errors.front().toXML());
+        }
+
+        // only the data of the requested checks is read
+        std::string checks;
+        ASSERT(AnalyzerInformation::readFileInfo(analyzerInfoFile, {"ctu"}, [&](const std::string &check, const tinyxml2::XMLElement *fileInfo) {
+            checks += check + ":" + fileInfo->FirstChildElement()->Name() + ";";
+        }));
+        ASSERT_EQUALS("ctu:function-call;", checks);
+
+        checks.clear();
+        ASSERT(AnalyzerInformation::readFileInfo(analyzerInfoFile, {}, [&](const std::string &check, const tinyxml2::XMLElement *fileInfo) {
+            checks += check + ":" + fileInfo->FirstChildElement()->Name() + ";";
+        }));
+        ASSERT_EQUALS("ctu:function-call;CheckUnusedFunctions:functiondecl;", checks);
+
+        // the file is analyzed again when the hash is changed
+        {
+            std::list<ErrorMessage> errors;
+            AnalyzerInformation info(xml);
+            ASSERT(info.analyzeFile(buildDir, "a.c", "", 0, 456, errors));
+            ASSERT(errors.empty());
+        }
+
+        std::remove(analyzerInfoFile.c_str());
+    }
+
+    void binaryFormat() const {
+        writeAndRead(false);
+
+        // a truncated file is analyzed again
+        const ScopedFile dummy("dummy", "", "analyzerinfo-truncated");
+        const std::string analyzerInfoFile = AnalyzerInformation::getAnalyzerInfoFile("analyzerinfo-truncated", "a.c", "", 0);
+        {
+            std::list<ErrorMessage> errors;
+            AnalyzerInformation info;
+            ASSERT(info.analyzeFile("analyzerinfo-truncated", "a.c", "", 0, 123, errors));
+        }
+        std::string content;
+        {
+            std::ifstream fin(analyzerInfoFile, std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        }
+        {
+            std::ofstream fout(analyzerInfoFile, std::ios::binary | std::ios::trunc);
+            fout.write(content.data(), content.size() - 1);
+        }
+        std::list<ErrorMessage> errors;
+        {
+            AnalyzerInformation info;
+            ASSERT(info.analyzeFile("analyzerinfo-truncated", "a.c", "", 0, 123, errors));
+        }
+        {
+            AnalyzerInformation info;
+            ASSERT(!info.analyzeFile("analyzerinfo-truncated", "a.c", "", 0, 123, errors));
+        }
+        std::remove(analyzerInfoFile.c_str());
+    }
+
+    void xmlFormat() const {
+        writeAndRead(true);
+    }
 };
 
 REGISTER_TEST(TestAnalyzerInformation)
@@ -220,6 +220,12 @@ private:
         TEST_CASE(maxConfigsMissingCount);
         TEST_CASE(maxConfigsInvalid);
         TEST_CASE(maxConfigsTooSmall);
+#if defined(HAS_THREADING_MODEL_THREAD)
+        TEST_CASE(configJobs);
+        TEST_CASE(configJobsInvalid);
+        TEST_CASE(configJobsTooSmall);
+        TEST_CASE(configJobsTooBig);
+#endif
         TEST_CASE(outputFormatText);
         TEST_CASE(outputFormatSarif);
         TEST_CASE(outputFormatXml);
@@ -309,6 +315,8 @@ private:
         TEST_CASE(showtimeNone);
         TEST_CASE(showtimeEmpty);
         TEST_CASE(showtimeInvalid);
+        TEST_CASE(showtimeTrace);
+        TEST_CASE(showtimeTraceEmpty);
         TEST_CASE(errorlist);
         TEST_CASE(errorlistWithCfg);
         TEST_CASE(errorlistExclusive);
@@ -335,6 +343,11 @@ private:
         TEST_CASE(checksMaxTime);
         TEST_CASE(checksMaxTime2);
         TEST_CASE(checksMaxTimeInvalid);
+        TEST_CASE(checksMaxTimeCheck);
+        TEST_CASE(checksMaxTimeCheckEmpty);
+        TEST_CASE(checksMaxTimeCheckInvalid);
+        TEST_CASE(reportSlowChecks);
+        TEST_CASE(reportSlowChecksInvalid);
 #ifdef HAS_THREADING_MODEL_FORK
         TEST_CASE(loadAverage);
         TEST_CASE(loadAverage2);
@@ -350,6 +363,12 @@ private:
         TEST_CASE(performanceValueflowMaxTimeInvalid);
         TEST_CASE(performanceValueFlowMaxIfCount);
         TEST_CASE(performanceValueFlowMaxIfCountInvalid);
+#if defined(HAS_THREADING_MODEL_THREAD)
+        TEST_CASE(performanceValueFlowJobs);
+        TEST_CASE(performanceValueFlowJobsInvalid);
+        TEST_CASE(performanceValueFlowJobsTooSmall);
+        TEST_CASE(performanceValueFlowJobsTooBig);
+#endif
         TEST_CASE(templateMaxTime);
         TEST_CASE(templateMaxTimeInvalid);
         TEST_CASE(templateMaxTimeInvalid2);
@@ -366,6 +385,13 @@ private:
         TEST_CASE(projectNoPaths);
         TEST_CASE(addon);
         TEST_CASE(addonMissing);
+        TEST_CASE(addonServer);
+        TEST_CASE(analyzerInfoFormatBinary);
+        TEST_CASE(analyzerInfoFormatXml);
+        TEST_CASE(analyzerInfoFormatInvalid);
+        TEST_CASE(dumpFormatXml);
+        TEST_CASE(dumpFormatBinary);
+        TEST_CASE(dumpFormatInvalid);
 #ifdef HAVE_RULES
         TEST_CASE(rule);
         TEST_CASE(ruleMissingPattern);
@@ -418,8 +444,13 @@ private:
 #if defined(HAS_THREADING_MODEL_FORK)
         TEST_CASE(executorProcess);
         TEST_CASE(executorProcessNoJobs);
+        TEST_CASE(processPool);
+#if defined(HAS_THREADING_MODEL_THREAD)
+        TEST_CASE(processPoolThread);
+#endif
 #else
         TEST_CASE(executorProcessNotSupported);
+        TEST_CASE(processPoolNotSupported);
 #endif
         TEST_CASE(checkLevelDefault);
         TEST_CASE(checkLevelNormal);
@@ -1319,6 +1350,37 @@ private:
         ASSERT_EQUALS("cppcheck: error: argument to '--max-configs=' must be greater than 0.\n", logger->str());
     }
 
+#if defined(HAS_THREADING_MODEL_THREAD)
+    void configJobs() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=4", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(4U, settings->configJobs);
+        ASSERT_EQUALS(1U, settings->jobs);
+    }
+
+    void configJobsInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=e", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--config-jobs=' is not valid - not an integer.\n", logger->str());
+    }
+
+    void configJobsTooSmall() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=0", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--config-jobs=' must be greater than 0.\n", logger->str());
+    }
+
+    void configJobsTooBig() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=1025", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--config-jobs=' is allowed to be 1024 at max.\n", logger->str());
+    }
+#endif
+
     void outputFormatText() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--output-format=text", "file.cpp"};
@@ -2021,6 +2083,21 @@ private:
         ASSERT_EQUALS("cppcheck: error: unrecognized --showtime mode: 'top10'. Supported modes: file, file-total, summary, top5, top5_file, top5_summary.\n", logger->str());
     }
 
+    void showtimeTrace() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--showtime-trace=trace.json", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS("trace.json", settings->showtimeTraceFile);
+        ASSERT(settings->showtime == SHOWTIME_MODES::SHOWTIME_NONE);
+    }
+
+    void showtimeTraceEmpty() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--showtime-trace=", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: no file provided for --showtime-trace\n", logger->str());
+    }
+
     void errorlist() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--errorlist"};
@@ -2201,6 +2278,44 @@ private:
         ASSERT_EQUALS("cppcheck: error: argument to '--checks-max-time=' is not valid - not an integer.\n", logger->str());
     }
 
+    void checksMaxTimeCheck() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--checks-max-time=STL usage:5", "--checks-max-time=Other:3", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(0, settings->checksMaxTime);
+        ASSERT_EQUALS(2, settings->checkMaxTime.size());
+        ASSERT_EQUALS(5, settings->checkMaxTime.at("STL usage"));
+        ASSERT_EQUALS(3, settings->checkMaxTime.at("Other"));
+    }
+
+    void checksMaxTimeCheckEmpty() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--checks-max-time=:5", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: no check provided for --checks-max-time.\n", logger->str());
+    }
+
+    void checksMaxTimeCheckInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--checks-max-time=Other:one", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: time of check 'Other' for --checks-max-time is not valid - not an integer.\n", logger->str());
+    }
+
+    void reportSlowChecks() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--report-slow-checks=10", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(10, settings->reportSlowChecks);
+    }
+
+    void reportSlowChecksInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--report-slow-checks=-1", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--report-slow-checks=' needs to be a positive integer.\n", logger->str());
+    }
+
 #ifdef HAS_THREADING_MODEL_FORK
     void loadAverage() {
         REDIRECT;
@@ -2288,6 +2403,36 @@ private:
         ASSERT_EQUALS("cppcheck: error: argument to '--performance-valueflow-max-if-count=' is not valid - not an integer.\n", logger->str());
     }
 
+#if defined(HAS_THREADING_MODEL_THREAD)
+    void performanceValueFlowJobs() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--performance-valueflow-jobs=4", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(4U, settings->vfOptions.jobs);
+    }
+
+    void performanceValueFlowJobsInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--performance-valueflow-jobs=e", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--performance-valueflow-jobs=' is not valid - not an integer.\n", logger->str());
+    }
+
+    void performanceValueFlowJobsTooSmall() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--performance-valueflow-jobs=0", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--performance-valueflow-jobs=' must be greater than 0.\n", logger->str());
+    }
+
+    void performanceValueFlowJobsTooBig() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--performance-valueflow-jobs=1025", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--performance-valueflow-jobs=' is allowed to be 1024 at max.\n", logger->str());
+    }
+#endif
+
     void templateMaxTime() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--template-max-time=12", "file.cpp"};
@@ -2399,6 +2544,55 @@ private:
         ASSERT_EQUALS("Did not find addon misra2.py\n", logger->str());
     }
 
+    void addonServer() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--addon-server", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(true, settings->addonServer);
+    }
+
+    void analyzerInfoFormatBinary() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--analyzer-info-format=binary", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS_ENUM(Settings::AnalyzerInfoFormat::binary, settings->analyzerInfoFormat);
+    }
+
+    void analyzerInfoFormatXml() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--analyzer-info-format=xml", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS_ENUM(Settings::AnalyzerInfoFormat::xml, settings->analyzerInfoFormat);
+    }
+
+    void analyzerInfoFormatInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--analyzer-info-format=json", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--analyzer-info-format=' must be 'binary' or 'xml'.\n", logger->str());
+    }
+
+    void dumpFormatXml() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--dump-format=xml", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS_ENUM(Settings::DumpFormat::xml, settings->dumpFormat);
+    }
+
+    void dumpFormatBinary() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--dump-format=binary", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS_ENUM(Settings::DumpFormat::binary, settings->dumpFormat);
+    }
+
+    void dumpFormatInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--dump-format=json", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--dump-format=' must be 'xml' or 'binary'.\n", logger->str());
+    }
+
     void signedChar() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--fsigned-char", "file.cpp"};
@@ -2842,6 +3036,24 @@ private:
         ASSERT_EQUALS_ENUM(Settings::ExecutorType::Process, settings->executor);
         ASSERT_EQUALS("cppcheck: '--executor' has no effect as only a single job will be used.\n", logger->str());
     }
+
+    void processPool() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "-j2", "--process-pool", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(true, settings->processPool);
+        ASSERT_EQUALS("", logger->str());
+    }
+
+#if defined(HAS_THREADING_MODEL_THREAD)
+    void processPoolThread() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "-j2", "--executor=thread", "--process-pool", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(true, settings->processPool);
+        ASSERT_EQUALS("cppcheck: '--process-pool' has no effect as the executor type 'process' is not used.\n", logger->str());
+    }
+#endif
 #else
     void executorProcessNotSupported() {
         REDIRECT;
@@ -2849,6 +3061,13 @@ private:
         ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
         ASSERT_EQUALS("cppcheck: error: executor type 'process' cannot be used as Cppcheck has not been built with a respective threading model.\n", logger->str());
     }
+
+    void processPoolNotSupported() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "-j2", "--process-pool", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: option '--process-pool' cannot be used as Cppcheck has not been built with a respective threading model.\n", logger->str());
+    }
 #endif
 
     // the CLI default to --check-level=normal
@@ -58,6 +58,7 @@ private:
         TEST_CASE(getErrorMessages);
         TEST_CASE(checkWithFile);
         TEST_CASE(checkWithFS);
+        TEST_CASE(checkConfigJobs);
         TEST_CASE(suppress_error_library);
         TEST_CASE(unique_errors);
         TEST_CASE(unique_errors_2);
@@ -149,6 +150,41 @@ private:
         ASSERT_EQUALS("nullPointer", *errorLogger.ids.cbegin());
     }
 
+    void checkConfigJobs() const
+    {
+        ScopedFile file("test.cpp",
+                        "void f1() { (void)*((int*)0); }\n"
+                        "#ifdef A\n"
+                        "void f2() { (void)*((int*)0); }\n"
+                        "#endif\n"
+                        "#ifdef B\n"
+                        "void f3() { (void)*((int*)0); }\n"
+                        "#endif\n"
+                        "#ifdef C\n"
+                        "void f5() { (void)*((int*)0); }\n"
+                        "#else\n"
+                        "void f4() { (void)*((int*)0); }\n"
+                        "#endif\n");
+
+        const auto getLines = [&](unsigned int configJobs) -> std::list<int> {
+            const auto s = dinit(Settings, $.templateFormat = templateFormat, $.force = true, $.configJobs = configJobs);
+            Suppressions supprs;
+            ErrorLogger2 errorLogger;
+            CppCheck cppcheck(s, supprs, errorLogger, false, {});
+            ASSERT_EQUALS(1, cppcheck.check(FileWithDetails(file.path(), Path::identify(file.path(), false), 0)));
+            std::list<int> lines;
+            for (const ErrorMessage& msg : errorLogger.errmsgs) {
+                if (msg.id == "nullPointer")
+                    lines.push_back(msg.callStack.back().line);
+            }
+            return lines;
+        };
+
+        const std::list<int> expected{1, 11, 3, 6, 9};
+        ASSERT_EQUALS_MSG(true, expected == getLines(1), "sequential");
+        ASSERT_EQUALS_MSG(true, expected == getLines(3), "parallel");
+    }
+
     void suppress_error_library() const
     {
         ScopedFile file("test.cpp",
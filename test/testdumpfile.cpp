@@ -0,0 +1,90 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dumpfile.h"
+#include "fixture.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+class TestDumpFile : public TestFixture {
+public:
+    TestDumpFile() : TestFixture("TestDumpFile") {}
+
+private:
+    void run() override {
+        TEST_CASE(binary);
+        TEST_CASE(binaryEscaped);
+        TEST_CASE(binaryLarge);
+    }
+
+    /** @return the items and strings of the binary dump as text */
+    static std::string convert(const std::string &xml) {
+        BinaryDumpBuffer buffer;
+        std::ostream out(&buffer);
+        out << xml;
+        const std::string data = buffer.data();
+        if (data.compare(0, 12, "CPPCHECKDUMP") != 0)
+            return "invalid magic";
+        const auto value = [&](std::size_t pos) {
+            std::uint32_t v = 0;
+            for (int i = 3; i >= 0; --i)
+                v = (v << 8) | static_cast<unsigned char>(data[pos + i]);
+            return v;
+        };
+        std::string ret = "version:" + std::to_string(value(12));
+        const std::uint32_t items = value(16);
+        for (std::uint32_t i = 0; i < items; ++i)
+            ret += " " + std::to_string(value(24 + 4 * i));
+        const std::string strings = data.substr(24 + 4 * items);
+        if (strings.size() != value(20))
+            return "invalid size";
+        ret += ' ';
+        for (const char c : strings)
+            ret += (c == '\0') ? '|' : c;
+        return ret;
+    }
+
+    void binary() const {
+        ASSERT_EQUALS("version:1 1 1 2 3 4 0 0 1 1 2 3 0 0 |dumps|language|c|token|",
+                      convert("<?xml version=\"1.0\"?>\n<dumps language=\"c\">\n  <token/>\n  <dumps language='c'></dumps>\n</dumps>\n"));
+        ASSERT_EQUALS("version:1 |", convert(""));
+    }
+
+    void binaryEscaped() const {
+        ASSERT_EQUALS("version:1 1 1 2 3 0 |tok|str|\"a<b>&'c\" d|",
+                      convert("<tok str=\"&quot;a&lt;b&gt;&amp;&apos;c&quot;\td\"/>"));
+        ASSERT_EQUALS("version:1 1 1 2 3 0 |tok|str|x>y/z|", convert("<tok str=\"x>y/z\" />"));
+    }
+
+    void binaryLarge() const {
+        // the XML is converted in chunks
+        std::string xml = "<dumps>";
+        for (int i = 0; i < 10000; ++i)
+            xml += "<token id=\"" + std::to_string(i % 3) + "\"/>\n";
+        xml += "</dumps>";
+        const std::string ret = convert(xml);
+        ASSERT_EQUALS(true, ret.compare(0, 26, "version:1 1 0 2 1 3 4 0 2 ") == 0);
+        ASSERT_EQUALS(true, ret.size() > 10000 * 10);
+        ASSERT_EQUALS("0 0 |dumps|token|id|0|1|2|", ret.substr(ret.size() - 26));
+    }
+};
+
+REGISTER_TEST(TestDumpFile)
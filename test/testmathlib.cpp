@@ -413,7 +413,7 @@ private:
             TokenList list{settingsDefault, Standards::Language::C};
             list.appendFileIfNew("test.c");
             auto tokensFrontBack = std::make_shared<TokensFrontBack>();
-            auto *tok = new Token(list, std::move(tokensFrontBack));
+            auto *tok = new (tokensFrontBack->arena) Token(list, tokensFrontBack);
             tok->str("invalid");
             ASSERT_THROW_INTERNAL_EQUALS(MathLib::toBigNumber(tok), INTERNAL, "Internal Error. MathLib::toBigNumber: invalid_argument: invalid");
             ASSERT_THROW_INTERNAL_EQUALS(MathLib::toBigNumber("invalid", tok), INTERNAL, "Internal Error. MathLib::toBigNumber: invalid_argument: invalid");
@@ -589,7 +589,7 @@ private:
             TokenList list{settingsDefault, Standards::Language::C};
             list.appendFileIfNew("test.c");
             auto tokensFrontBack = std::make_shared<TokensFrontBack>();
-            auto *tok = new Token(list, std::move(tokensFrontBack));
+            auto *tok = new (tokensFrontBack->arena) Token(list, tokensFrontBack);
             tok->str("invalid");
             ASSERT_THROW_INTERNAL_EQUALS(MathLib::toBigUNumber(tok), INTERNAL, "Internal Error. MathLib::toBigUNumber: invalid_argument: invalid");
             ASSERT_THROW_INTERNAL_EQUALS(MathLib::toBigUNumber("invalid", tok), INTERNAL, "Internal Error. MathLib::toBigUNumber: invalid_argument: invalid");
@@ -719,7 +719,7 @@ private:
             TokenList list{settingsDefault, Standards::Language::C};
             list.appendFileIfNew("test.c");
             auto tokensFrontBack = std::make_shared<TokensFrontBack>();
-            auto *tok = new Token(list, std::move(tokensFrontBack));
+            auto *tok = new (tokensFrontBack->arena) Token(list, tokensFrontBack);
             tok->str("invalid");
             ASSERT_THROW_INTERNAL_EQUALS(MathLib::toDoubleNumber(tok), INTERNAL, "Internal Error. MathLib::toDoubleNumber: conversion failed: invalid");
             ASSERT_THROW_INTERNAL_EQUALS(MathLib::toDoubleNumber("invalid", tok), INTERNAL, "Internal Error. MathLib::toDoubleNumber: conversion failed: invalid");
@@ -31,7 +31,11 @@
 #include "fixture.h"
 #include "helpers.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <functional>
 #include <list>
 #include <map>
 #include <set>
@@ -294,6 +298,9 @@ private:
         TEST_CASE(hashCalculation);
 
         TEST_CASE(standard);
+
+        TEST_CASE(headerCache);
+        TEST_CASE(rawTokensBuildDir);
     }
 
     std::string getConfigsStr(const char filedata[], const char *arg = nullptr) {
@@ -2618,6 +2625,76 @@ private:
             ASSERT(!tokenlist.front()); // nothing is tokenized when an unknown standard is provided
         }
     }
+
+    std::string getcodeWithHeaderCache(const char code[], std::size_t &hits, std::size_t &misses) {
+        std::istringstream istr(code);
+        std::vector<std::string> files;
+        simplecpp::TokenList tokens(istr, files, "test.c");
+        Preprocessor preprocessor(settingsDefault, *this, Standards::Language::C);
+        ASSERT(preprocessor.loadFiles(tokens, files));
+        hits = preprocessor.getHeaderCacheHits();
+        misses = preprocessor.getHeaderCacheMisses();
+        std::string ret = preprocessor.getcode(tokens, "", files, false);
+        ret.erase(std::remove(ret.begin(), ret.end(), Preprocessor::macroChar), ret.end());
+        return ret;
+    }
+
+    void headerCache() {
+        const char code[] = "#include \"headercache.h\"\n"
+                            "int y = A;";
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+
+        {
+            ScopedFile header("headercache.h", "#define A 1\nint x;\n");
+            ASSERT_EQUALS("\nint x ; int y = 1 ;", getcodeWithHeaderCache(code, hits, misses));
+            ASSERT_EQUALS(0, hits);
+            ASSERT_EQUALS(1, misses);
+
+            // the raw tokens of the header are reused by the next translation unit
+            ASSERT_EQUALS("\nint x ; int y = 1 ;", getcodeWithHeaderCache(code, hits, misses));
+            ASSERT_EQUALS(1, hits);
+            ASSERT_EQUALS(0, misses);
+        }
+
+        {
+            // header is tokenized again when its content is changed
+            ScopedFile header("headercache.h", "#define A 2\nint x;\n");
+            ASSERT_EQUALS("\nint x ; int y = 2 ;", getcodeWithHeaderCache(code, hits, misses));
+            ASSERT_EQUALS(0, hits);
+            ASSERT_EQUALS(1, misses);
+        }
+    }
+
+    void rawTokensBuildDir() {
+        const std::string content = "#define A 1\nint x = A; // comment\n";
+        const ScopedFile builddir("dummy", "", "rawtokens-builddir");
+        const ScopedFile source("rawtokens.c", content);
+        const std::string rawTokensFile = Path::join("rawtokens-builddir", std::to_string(std::hash<std::string>{}(content)) + ".rawtokens");
+
+        std::vector<std::string> files1;
+        const simplecpp::TokenList tokens1 = Preprocessor::createRawTokens(source.path(), files1, nullptr, "rawtokens-builddir");
+        ASSERT_EQUALS("# define A 1\nint x = A ; // comment", tokens1.stringify());
+        ASSERT(Path::isFile(rawTokensFile));
+
+        // the raw tokens are read from the build dir
+        std::vector<std::string> files2;
+        const simplecpp::TokenList tokens2 = Preprocessor::createRawTokens(source.path(), files2, nullptr, "rawtokens-builddir");
+        ASSERT_EQUALS(tokens1.stringify(), tokens2.stringify());
+        ASSERT_EQUALS(1U, files2.size());
+        ASSERT_EQUALS(source.path(), files2[0]);
+
+        // a truncated file in the build dir is ignored
+        {
+            std::ofstream fout(rawTokensFile, std::ios::binary | std::ios::trunc);
+            fout << "cppcheck-rawtokens";
+        }
+        std::vector<std::string> files3;
+        const simplecpp::TokenList tokens3 = Preprocessor::createRawTokens(source.path(), files3, nullptr, "rawtokens-builddir");
+        ASSERT_EQUALS(tokens1.stringify(), tokens3.stringify());
+
+        std::remove(rawTokensFile.c_str());
+    }
 };
 
 REGISTER_TEST(TestPreprocessor)
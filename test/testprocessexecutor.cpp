@@ -53,6 +53,7 @@ private:
     {
         CheckOptions() = default;
         bool quiet = true;
+        bool processPool = false;
         SHOWTIME_MODES showtime = SHOWTIME_MODES::SHOWTIME_NONE;
         const char* plistOutput = nullptr;
         std::vector<std::string> filesList;
@@ -93,6 +94,7 @@ private:
         s.jobs = jobs;
         s.showtime = opt.showtime;
         s.quiet = opt.quiet;
+        s.processPool = opt.processPool;
         if (opt.plistOutput)
             s.plistOutput = opt.plistOutput;
         s.templateFormat = "{callstack}: ({severity}) {inconclusive:inconclusive: }{message}";
@@ -149,6 +151,9 @@ private:
         TEST_CASE(showtime_file_total);
         TEST_CASE(suppress_error_library);
         TEST_CASE(unique_errors);
+        TEST_CASE(pool_many_files);
+        TEST_CASE(pool_less_files);
+        TEST_CASE(pool_unique_errors);
 #endif // !WIN32
     }
 
@@ -368,6 +373,40 @@ private:
         ASSERT_EQUALS("[" + inc_h.name() + ":3:11]: (error) Null pointer dereference: (int*)0 [nullPointer]\n", errout_str());
     }
 
+    void pool_many_files() {
+        const int num_files = 20;
+        check(3, num_files, num_files,
+              "int main()\n"
+              "{\n"
+              "  {int i = *((int*)0);}\n"
+              "  return 0;\n"
+              "}", dinit(CheckOptions, $.processPool = true));
+        ASSERT_EQUALS(num_files, cppcheck::count_all_of(errout_str(), "(error) Null pointer dereference: (int*)0"));
+    }
+
+    void pool_less_files() {
+        check(4, 1, 1,
+              "int main()\n"
+              "{\n"
+              "  {int i = *((int*)0);}\n"
+              "  return 0;\n"
+              "}", dinit(CheckOptions, $.processPool = true));
+        ASSERT_EQUALS("[" + fprefix() + "_1.cpp:3:14]: (error) Null pointer dereference: (int*)0 [nullPointer]\n", errout_str());
+    }
+
+    void pool_unique_errors() {
+        SUPPRESS;
+        ScopedFile inc_h(fprefix() + ".h",
+                         "inline void f()\n"
+                         "{\n"
+                         "  (void)*((int*)0);\n"
+                         "}");
+        check(2, 4, 4,
+              "#include \"" + inc_h.name() +"\"", dinit(CheckOptions, $.processPool = true));
+        // the errors of the files that are checked by the same child are made unique by the executor as well
+        ASSERT_EQUALS("[" + inc_h.name() + ":3:11]: (error) Null pointer dereference: (int*)0 [nullPointer]\n", errout_str());
+    }
+
     // TODO: test whole program analysis
 };
 
@@ -0,0 +1,97 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fixture.h"
+#include "ruleengine.h"
+
+#include <string>
+#include <vector>
+
+class TestRuleEngine : public TestFixture {
+public:
+    TestRuleEngine() : TestFixture("TestRuleEngine") {}
+
+private:
+    void run() override {
+        TEST_CASE(requiredLiterals);
+        TEST_CASE(requiredLiteralsQuantifiers);
+        TEST_CASE(requiredLiteralsUnknown);
+        TEST_CASE(candidates);
+    }
+
+    static std::string literals(const std::string &pattern) {
+        std::string ret;
+        for (const std::string &literal : RulePrefilter::requiredLiterals(pattern))
+            ret += "[" + literal + "]";
+        return ret;
+    }
+
+    void requiredLiterals() const {
+        ASSERT_EQUALS("[}][catch][(][)][{]", literals("\\}\\s*catch\\s*\\(.*\\)\\s*\\{\\s*\\}"));
+        ASSERT_EQUALS("[ . find ( \"][\" ) == ][ ]", literals(" \\. find \\( \"[^\"]+?\" \\) == \\d+ "));
+        ASSERT_EQUALS("[ * ][ = 0 ;]", literals("(\\b\\w+\\b) \\* (\\b\\w+\\b) = 0 ;"));
+        ASSERT_EQUALS("[ab][d]", literals("ab[c]d"));
+        ASSERT_EQUALS("[b]", literals("[]a]b"));
+        ASSERT_EQUALS("[cd]", literals("(?:ab)?cd"));
+        ASSERT_EQUALS("[a{b]", literals("a{b"));
+        ASSERT_EQUALS("", literals(".*"));
+    }
+
+    void requiredLiteralsQuantifiers() const {
+        ASSERT_EQUALS("[a][c]", literals("ab?c"));
+        ASSERT_EQUALS("[a][c]", literals("ab*?c"));
+        ASSERT_EQUALS("[foo][bar]", literals("foo+bar"));
+        ASSERT_EQUALS("[bc]", literals("a{0,2}bc"));
+        ASSERT_EQUALS("[x][yz]", literals("x{2}yz"));
+        ASSERT_EQUALS("[q.][s]", literals("q\\.r*s"));
+    }
+
+    void requiredLiteralsUnknown() const {
+        // alternatives, options and escapes with arguments are not analyzed
+        ASSERT_EQUALS("", literals("ab|cd"));
+        ASSERT_EQUALS("", literals("(?i)abc"));
+        ASSERT_EQUALS("", literals("ab\\x41"));
+        ASSERT_EQUALS("", literals("ab(c"));
+        ASSERT_EQUALS("", literals("abc)"));
+    }
+
+    void candidates() const {
+        const RulePrefilter prefilter({" if \\( \\w+ \\) \\{", " \\. find \\( \"[^\"]+?\" \\) == \\d+ ", "ab|cd", " memset \\("});
+
+        std::vector<bool> c = prefilter.candidates(" void f ( ) { if ( x ) { } }");
+        ASSERT_EQUALS(4, c.size());
+        ASSERT_EQUALS(true, c[0]);
+        ASSERT_EQUALS(false, c[1]);
+        ASSERT_EQUALS(true, c[2]);
+        ASSERT_EQUALS(false, c[3]);
+
+        c = prefilter.candidates(" s . find ( \"t\" ) == 17 ; memset ( p");
+        ASSERT_EQUALS(false, c[0]);
+        ASSERT_EQUALS(true, c[1]);
+        ASSERT_EQUALS(true, c[2]);
+        ASSERT_EQUALS(true, c[3]);
+
+        c = prefilter.candidates("");
+        ASSERT_EQUALS(false, c[0]);
+        ASSERT_EQUALS(false, c[1]);
+        ASSERT_EQUALS(true, c[2]);
+        ASSERT_EQUALS(false, c[3]);
+    }
+};
+
+REGISTER_TEST(TestRuleEngine)
@@ -220,6 +220,7 @@ private:
         TEST_CASE(template179);
         TEST_CASE(template180);
         TEST_CASE(template181);
+        TEST_CASE(template182); // instantiations of several templates with the same and different names
         TEST_CASE(template_specialization_1);  // #7868 - template specialization template <typename T> struct S<C<T>> {..};
         TEST_CASE(template_specialization_2);  // #7868 - template specialization template <typename T> struct S<C<T>> {..};
         TEST_CASE(template_specialization_3);
@@ -4634,6 +4635,29 @@ private:
         ASSERT_EQUALS(exp2, tok(code2));
     }
 
+    void template182() {
+        const char code[] = "template<class T> struct A { T t; };\n"
+                            "template<class T> struct B { A<T> a; };\n"
+                            "template<class T> T f(T t) { return t; }\n"
+                            "A<A<int>> x;\n"
+                            "B<char> y;\n"
+                            "int z = f<int>(f<int>(1));\n";
+        const char exp[] = "struct A<int> ; "
+                           "struct A<A<int>> ; "
+                           "struct A<char> ; "
+                           "struct B<char> ; "
+                           "int f<int> ( int t ) ; "
+                           "A<A<int>> x ; "
+                           "B<char> y ; "
+                           "int z ; z = f<int> ( f<int> ( 1 ) ) ; "
+                           "int f<int> ( int t ) { return t ; } "
+                           "struct B<char> { A<char> a ; } ; "
+                           "struct A<int> { int t ; } ; "
+                           "struct A<A<int>> { A<int> t ; } ; "
+                           "struct A<char> { char t ; } ;";
+        ASSERT_EQUALS(exp, tok(code));
+    }
+
     void template_specialization_1() {  // #7868 - template specialization template <typename T> struct S<C<T>> {..};
         const char code[] = "template <typename T> struct C {};\n"
                             "template <typename T> struct S {a};\n"
@@ -112,6 +112,7 @@ private:
         TEST_CASE(suppressionFromErrorMessage);
 
         TEST_CASE(suppressionWildcard);
+        TEST_CASE(suppressionIndex);
     }
 
     void suppressionsBadId1() const {
@@ -1800,6 +1801,42 @@ private:
             ASSERT(!suppressions.getUnmatchedGlobalSuppressions(true).empty());
         }
     }
+
+    void suppressionIndex() const {
+        SuppressionList suppressions;
+        ASSERT_EQUALS("", suppressions.addSuppressionLine("abc"));
+        ASSERT_EQUALS("", suppressions.addSuppressionLine("def:test.cpp"));
+        ASSERT_EQUALS("", suppressions.addSuppressionLine("ghi:test.cpp:10"));
+        ASSERT_EQUALS("", suppressions.addSuppressionLine("jkl:src\\test.cpp"));
+        ASSERT_EQUALS("", suppressions.addSuppressionLine("mno:src/*.cpp"));
+        ASSERT_EQUALS("", suppressions.addSuppressionLine("p*:other.cpp"));
+
+        ASSERT_EQUALS(false, suppressions.isSuppressed(errorMessage("xyz", "other.cpp", 1)));
+        ASSERT_EQUALS(true, suppressions.isSuppressed(errorMessage("abc", "other.cpp", 1)));
+        ASSERT_EQUALS(false, suppressions.isSuppressed(errorMessage("def", "other.cpp", 1)));
+        ASSERT_EQUALS(true, suppressions.isSuppressed(errorMessage("def", "test.cpp", 1)));
+        ASSERT_EQUALS(false, suppressions.isSuppressed(errorMessage("ghi", "test.cpp", 11)));
+        ASSERT_EQUALS(true, suppressions.isSuppressed(errorMessage("ghi", "test.cpp", 10)));
+        ASSERT_EQUALS(true, suppressions.isSuppressed(errorMessage("jkl", "src/test.cpp", 1)));
+        ASSERT_EQUALS(false, suppressions.isSuppressed(errorMessage("mno", "test.cpp", 1)));
+        ASSERT_EQUALS(true, suppressions.isSuppressed(errorMessage("mno", "src/x.cpp", 1)));
+        ASSERT_EQUALS(true, suppressions.isSuppressed(errorMessage("pqr", "other.cpp", 1)));
+        ASSERT_EQUALS(false, suppressions.isSuppressed(errorMessage("pqr", "test.cpp", 1)));
+
+        // the suppressions of a file are checked by every message of the file
+        ASSERT_EQUALS("", suppressions.addSuppressionLine("stu:checked.cpp"));
+        ASSERT_EQUALS("", suppressions.addSuppressionLine("vwx:checked.cpp:5"));
+        ASSERT_EQUALS(false, suppressions.isSuppressed(errorMessage("abd", "checked.cpp", 1)));
+        const std::list<SuppressionList::Suppression> supprs = suppressions.getSuppressions();
+        ASSERT_EQUALS(8, supprs.size());
+        auto it = supprs.cbegin();
+        std::advance(it, 6);
+        ASSERT(it->checked);
+        ASSERT(!it->matched);
+        ++it;
+        ASSERT(!it->checked);
+        ASSERT(!it->matched);
+    }
 };
 
 REGISTER_TEST(TestSuppressions)
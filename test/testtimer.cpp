@@ -19,8 +19,11 @@
 #include "fixture.h"
 #include "timer.h"
 
+#include <chrono>
 #include <cmath>
-#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
 
 class TestTimer : public TestFixture {
 public:
@@ -30,15 +33,67 @@ private:
 
     void run() override {
         TEST_CASE(result);
+        TEST_CASE(slowest);
+        TEST_CASE(trace);
     }
 
     void result() const {
         TimerResultsData t1;
-        t1.mClocks = ~static_cast<std::clock_t>(0);
+        t1.mWall = std::chrono::hours(1);
         ASSERT(t1.seconds() > 100.0);
 
-        t1.mClocks = CLOCKS_PER_SEC * 5 / 2;
+        t1.mWall = std::chrono::milliseconds(2500);
+        t1.mCpu = std::chrono::milliseconds(1500);
         ASSERT(std::fabs(t1.seconds()-2.5) < 0.01);
+        ASSERT(std::fabs(t1.cpuSeconds()-1.5) < 0.01);
+    }
+
+    void slowest() const {
+        TimerSlowest slowest;
+        slowest.add("a", std::chrono::seconds(2), 3);
+        slowest.add("b", std::chrono::seconds(4), 3);
+        slowest.add("c", std::chrono::seconds(1), 3);
+        slowest.add("d", std::chrono::seconds(3), 3);
+        slowest.add("e", std::chrono::milliseconds(500), 3);
+
+        const std::vector<std::pair<std::string, std::chrono::nanoseconds>> results = slowest.results();
+        ASSERT_EQUALS(3, results.size());
+        ASSERT_EQUALS("b", results[0].first);
+        ASSERT_EQUALS("d", results[1].first);
+        ASSERT_EQUALS("a", results[2].first);
+        ASSERT(results[0].second == std::chrono::seconds(4));
+
+        slowest.reset();
+        ASSERT(slowest.results().empty());
+    }
+
+    void trace() const {
+        {
+            const Timer t("outer \"scope\"", SHOWTIME_MODES::SHOWTIME_NONE);
+        }
+        ASSERT_EQUALS("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}", TimerTrace::toJson());
+
+        TimerTrace::start();
+        {
+            Timer outer("outer \"scope\"", SHOWTIME_MODES::SHOWTIME_NONE);
+            {
+                const Timer inner("inner", SHOWTIME_MODES::SHOWTIME_NONE);
+            }
+            outer.stop();
+        }
+        const std::string json = TimerTrace::toJson();
+        TimerTrace::reset();
+
+        // the enclosing scope is written first
+        const std::string::size_type outerPos = json.find("\"name\":\"outer \\\"scope\\\"\"");
+        const std::string::size_type innerPos = json.find("\"name\":\"inner\"");
+        ASSERT(outerPos != std::string::npos);
+        ASSERT(innerPos != std::string::npos);
+        ASSERT(outerPos < innerPos);
+        ASSERT(json.find("\"ph\":\"X\"") != std::string::npos);
+        ASSERT(json.find("\"args\":{\"cpu\":") != std::string::npos);
+
+        ASSERT_EQUALS("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}", TimerTrace::toJson());
     }
 };
 
@@ -22,6 +22,7 @@
 #include "standards.h"
 #include "token.h"
 #include "tokenlist.h"
+#include "tokenmatch.h"
 #include "vfvalue.h"
 
 #include <algorithm>
@@ -84,6 +85,7 @@ private:
         TEST_CASE(matchOr);
         TEST_CASE(matchOp);
         TEST_CASE(matchConstOp);
+        TEST_CASE(matchCompiled);
 
         TEST_CASE(isArithmeticalOp);
         TEST_CASE(isOp);
@@ -127,11 +129,16 @@ private:
         TEST_CASE(update_property_info_replace); // #13743
 
         TEST_CASE(varid_reset);
+
+        TEST_CASE(valueCount);
+        TEST_CASE(valueChangedScopes);
+        TEST_CASE(arena);
+        TEST_CASE(strings);
     }
 
     void nextprevious() const {
         auto tokensFrontBack = std::make_shared<TokensFrontBack>();
-        auto *token = new Token(list, std::move(tokensFrontBack));
+        auto *token = new (tokensFrontBack->arena) Token(list, tokensFrontBack);
         token->str("1");
         (void)token->insertToken("2");
         (void)token->next()->insertToken("3");
@@ -861,6 +868,40 @@ private:
         }
     }
 
+    void matchCompiled() {
+        SimpleTokenizer tokenizer(*this);
+        ASSERT(tokenizer.tokenize("int f(int a, const char *s) {\n"
+                                  "    if (a == 1 || (a | 2) > 0) { return s[0] != 'x' && true; }\n"
+                                  "    else { a += 3; }\n"
+                                  "    return \"s\" == s;\n"
+                                  "}"));
+
+        // the compiled pattern has the same result as Token::Match() for every token
+#define ASSERT_MATCH_COMPILED(pattern, varid) \
+    for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) \
+        ASSERT_EQUALS_MSG(Token::Match(tok, pattern, varid), TOKEN_MATCH_VARID(tok, pattern, varid), tok->str() + " " pattern)
+
+        ASSERT_MATCH_COMPILED("int", 0);
+        ASSERT_MATCH_COMPILED("int %name% (", 0);
+        ASSERT_MATCH_COMPILED("f (", 0);
+        ASSERT_MATCH_COMPILED("%type% %var% ,|)", 0);
+        ASSERT_MATCH_COMPILED("const| char *", 0);
+        ASSERT_MATCH_COMPILED("%var% %comp%|%or% %num%", 0);
+        ASSERT_MATCH_COMPILED("%oror%|%op% (|%name%", 0);
+        ASSERT_MATCH_COMPILED("%cop%", 0);
+        ASSERT_MATCH_COMPILED("%assign% %any% ;", 0);
+        ASSERT_MATCH_COMPILED("[;{}] %name%", 0);
+        ASSERT_MATCH_COMPILED("[[(] 0|%char%|]", 0);
+        ASSERT_MATCH_COMPILED("} !!else", 0);
+        ASSERT_MATCH_COMPILED("%str%|%bool%|%char% ;|==|&&", 0);
+        ASSERT_MATCH_COMPILED("return %any% ; !!}", 0);
+        ASSERT_MATCH_COMPILED("%varid% [|)|=", 1);
+        ASSERT_MATCH_COMPILED("%name% %varid% {|)", 2);
+#undef ASSERT_MATCH_COMPILED
+
+        ASSERT_THROW_INTERNAL_EQUALS(TOKEN_MATCH(tokenizer.tokens(), "int %varid%"), INTERNAL, "Internal error. Token::Match called with varid 0. Please report this to Cppcheck developers");
+    }
+
 
     void isArithmeticalOp() const {
         for (auto test_op = arithmeticalOps.cbegin(); test_op != arithmeticalOps.cend(); ++test_op) {
@@ -1522,6 +1563,117 @@ private:
         tok.varId(0);
         assert_tok(&tok, Token::Type::eType, /*l=*/ false, /*std=*/ true);
     }
+
+    void valueCount() const {
+        auto tokensFrontBack = std::make_shared<TokensFrontBack>();
+        const TokensFrontBack &counts = *tokensFrontBack;
+        auto *token = new (tokensFrontBack->arena) Token(list, tokensFrontBack);
+        token->str("a");
+        (void)token->insertToken("b");
+        Token *b = token->next();
+
+        ASSERT(token->addValue(ValueFlow::Value(1)));
+        ASSERT(token->addValue(ValueFlow::Value(2)));
+        ASSERT(!token->addValue(ValueFlow::Value(1)));
+        ASSERT_EQUALS(2U, counts.valueCount);
+        ASSERT_EQUALS(2U, counts.addedValues);
+
+        ValueFlow::Value known(3);
+        known.setKnown();
+        ASSERT(b->addValue(known));
+        ASSERT(token->addValue(known)); // removes the possible values
+        ASSERT_EQUALS(2U, counts.valueCount);
+        ASSERT_EQUALS(4U, counts.addedValues);
+
+        b->removeValues([](const ValueFlow::Value&) {
+            return true;
+        });
+        ASSERT_EQUALS(1U, counts.valueCount);
+
+        ASSERT(b->addValue(ValueFlow::Value(4)));
+        b->deleteThis(); // takes the values of the previous token
+        ASSERT_EQUALS(1U, counts.valueCount);
+        ASSERT_EQUALS(3, b->values().front().intvalue);
+
+        b->clearValueFlow();
+        ASSERT_EQUALS(0U, counts.valueCount);
+        ASSERT_EQUALS(5U, counts.addedValues);
+
+        TokenList::deleteTokens(b);
+    }
+
+    void valueChangedScopes() {
+        SimpleTokenizer tokenizer(*this);
+        ASSERT(tokenizer.tokenize("int x; void f() { x = 1; }"));
+        Token *x1 = Token::findsimplematch(tokenizer.tokens(), "x ;");
+        Token *x2 = Token::findsimplematch(x1, "x =");
+        const Scope *functionScope = x2->scope();
+
+        std::vector<const Scope*> scopes;
+        tokenizer.list.setValueChangedScopes(&scopes);
+        ASSERT(x1->addValue(ValueFlow::Value(100)));
+        ASSERT(!x1->addValue(ValueFlow::Value(100)));
+        ASSERT(x2->addValue(ValueFlow::Value(100)));
+        ASSERT(x2->addValue(ValueFlow::Value(101)));
+        x1->removeValues([](const ValueFlow::Value&) {
+            return false;
+        });
+        x1->clearValueFlow();
+        ASSERT_EQUALS(3U, scopes.size());
+        ASSERT(scopes[0] == x1->scope());
+        ASSERT(scopes[1] == functionScope);
+        ASSERT(scopes[2] == x1->scope());
+
+        tokenizer.list.setValueChangedScopes(nullptr);
+        ASSERT(x1->addValue(ValueFlow::Value(100)));
+        ASSERT_EQUALS(3U, scopes.size());
+    }
+
+    void arena() {
+        SimpleTokenizer tokenizer(*this);
+        ASSERT(tokenizer.tokenize("int x;"));
+        const TokenArena &arena = tokenizer.list.getArena();
+        const std::size_t allocations = arena.allocations();
+        ASSERT(allocations > 0);
+        ASSERT_EQUALS(1U, arena.blocks());
+
+        // the token and its data are allocated in the arena
+        tokenizer.list.front()->insertToken("const");
+        ASSERT_EQUALS(allocations + 2, arena.allocations());
+        ASSERT_EQUALS(1U, arena.blocks());
+
+        // released tokens are not returned to the arena
+        tokenizer.list.front()->deleteNext();
+        ASSERT_EQUALS(allocations + 2, arena.allocations());
+    }
+
+    void strings() {
+        SimpleTokenizer tokenizer(*this);
+        ASSERT(tokenizer.tokenize("int x; int y = x | 1;"));
+        const Token *int1 = tokenizer.tokens();
+        const Token *x1 = int1->next();
+        const Token *int2 = Token::findsimplematch(x1, "int");
+        const Token *x2 = Token::findsimplematch(int2, "x");
+        const Token *y = int2->next();
+
+        // equal strings are stored once
+        ASSERT(&int1->str() == &int2->str());
+        ASSERT(&x1->str() == &x2->str());
+        ASSERT_EQUALS(x1->strId(), x2->strId());
+        ASSERT(x1->strId() != y->strId());
+
+        // keywords and operators have fixed ids
+        ASSERT_EQUALS(TokenStrings::fixedId("int"), int1->strId());
+        ASSERT_EQUALS(TokenStrings::fixedId("|"), x2->next()->strId());
+        ASSERT(x1->strId() > TokenStrings::maxFixedId());
+        ASSERT_EQUALS(0, TokenStrings::fixedId("x"));
+
+        // changing the string interns the new string
+        Token *tok = const_cast<Token *>(y);
+        tok->str("x");
+        ASSERT(&tok->str() == &x1->str());
+        ASSERT_EQUALS(x1->strId(), tok->strId());
+    }
 #undef assert_tok
 };
 
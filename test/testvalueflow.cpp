@@ -175,6 +175,9 @@ private:
         mNewTemplate = true;
 
         TEST_CASE(performanceIfCount);
+#ifdef HAS_THREADING_MODEL_THREAD
+        TEST_CASE(performanceJobs);
+#endif
     }
 
     static bool isNotTokValue(const ValueFlow::Value &val) {
@@ -2178,8 +2181,7 @@ private:
                 "}");
         ASSERT_EQUALS_WITHOUT_LINENUMBERS(
             "[test.cpp:3]: (debug) valueFlowConditionExpressions bailout: Skipping function due to incomplete variable a\n"
-            "[test.cpp:4]: (debug) valueflow.cpp:1260:(valueFlow) bailout: variable 'x', condition is defined in macro\n"
-            "[test.cpp:4]: (debug) valueflow.cpp:1260:(valueFlow) bailout: variable 'x', condition is defined in macro\n", // duplicate
+            "[test.cpp:4]: (debug) valueflow.cpp:1260:(valueFlow) bailout: variable 'x', condition is defined in macro\n",
             errout_str());
 
         bailout("#define FREE(obj) ((obj) ? (free((char *) (obj)), (obj) = 0) : 0)\n" // #8349
@@ -2204,8 +2206,7 @@ private:
                 "}");
         ASSERT_EQUALS_WITHOUT_LINENUMBERS(
             "[test.cpp:3]: (debug) valueFlowConditionExpressions bailout: Skipping function due to incomplete variable a\n"
-            "[test.cpp:2]: (debug) valueflow.cpp::(valueFlow) bailout: valueFlowAfterCondition: bailing in conditional block\n"
-            "[test.cpp:2]: (debug) valueflow.cpp::(valueFlow) bailout: valueFlowAfterCondition: bailing in conditional block\n", // duplicate
+            "[test.cpp:2]: (debug) valueflow.cpp::(valueFlow) bailout: valueFlowAfterCondition: bailing in conditional block\n",
             errout_str());
 
         // #5721 - FP
@@ -2220,8 +2221,7 @@ private:
                 "    if (abc) {}\n"
                 "}");
         ASSERT_EQUALS_WITHOUT_LINENUMBERS(
-            "[test.cpp:3]: (debug) valueflow.cpp:6730:(valueFlow) bailout: valueFlowAfterCondition: bailing in conditional block\n"
-            "[test.cpp:3]: (debug) valueflow.cpp:6730:(valueFlow) bailout: valueFlowAfterCondition: bailing in conditional block\n", // duplicate
+            "[test.cpp:3]: (debug) valueflow.cpp:6730:(valueFlow) bailout: valueFlowAfterCondition: bailing in conditional block\n",
             errout_str());
     }
 
@@ -9042,6 +9042,43 @@ private:
                "}\n";
         ASSERT_EQUALS(1U, tokenValues(code, "v .", &s).size());
     }
+
+#ifdef HAS_THREADING_MODEL_THREAD
+    void performanceJobs() {
+        /*const*/ Settings s = settingsBuilder().library("std.cfg").build();
+        s.vfOptions.jobs = 2;
+
+        // independent functions are analyzed by different threads
+        const char* code = "int f(int a) {\n"
+                           "  int x = a;\n"
+                           "  if (a == 1) {}\n"
+                           "  return x;\n"
+                           "}\n"
+                           "int g() {\n"
+                           "  int x = 3;\n"
+                           "  return x;\n"
+                           "}\n";
+        ASSERT_EQUALS(true, testValueOfX(code, 4U, 1, &s));
+        ASSERT_EQUALS(true, testValueOfX(code, 8U, 3, &s));
+
+        // the callee is analyzed along with the caller
+        code = "int h(int a) {\n"
+               "  int x = a;\n"
+               "  return x;\n"
+               "}\n"
+               "int f() {\n"
+               "  int x = 2;\n"
+               "  return h(x);\n"
+               "}\n"
+               "int g() {\n"
+               "  int x = 3;\n"
+               "  return x;\n"
+               "}\n";
+        ASSERT_EQUALS(true, testValueOfX(code, 3U, 2, &s));
+        ASSERT_EQUALS(true, testValueOfX(code, 7U, 2, &s));
+        ASSERT_EQUALS(true, testValueOfX(code, 11U, 3, &s));
+    }
+#endif
 };
 
 REGISTER_TEST(TestValueFlow)
@@ -475,6 +475,7 @@ int main(int argc, char **argv)
     libfiles_h.emplace("precompiled.h");
     libfiles_h.emplace("smallvector.h");
     libfiles_h.emplace("sourcelocation.h");
+    libfiles_h.emplace("tokenmatch.h");
     libfiles_h.emplace("tokenrange.h");
     libfiles_h.emplace("valueptr.h");
     libfiles_h.emplace("version.h");
@@ -0,0 +1,89 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Microbenchmark of Token::Match(), TOKEN_MATCH() and tools/matchcompiler.py
+
+#include "patterns.h"
+
+#include "settings.h"
+#include "standards.h"
+#include "token.h"
+#include "tokenlist.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static const char code[] =
+    "int f%d(int a, int b) {\n"
+    "    int x = 0;\n"
+    "    if (a > b) { x = a + b; } else { x = g(a); }\n"
+    "    while (x < 10) { x += 2; }\n"
+    "    for (int i = 0; i < a; ++i) { b = b * i; }\n"
+    "    switch (x) { case 1: return b; default: break; }\n"
+    "    return x;\n"
+    "}\n"
+    "struct S%d { void m() const { h(1, 2); } };\n";
+
+static void run(const char *name, std::size_t (*count)(const Token *), const Token *tokens, int iterations, std::size_t tokenCount)
+{
+    std::size_t matches = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        matches += count(tokens);
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << name << ": " << (ns / (static_cast<double>(iterations) * tokenCount)) << " ns/token (" << matches << " matches)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const int functions = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    std::string src;
+    for (int i = 0; i < functions; ++i) {
+        std::string s = code;
+        std::string::size_type pos;
+        while ((pos = s.find("%d")) != std::string::npos)
+            s.replace(pos, 2, std::to_string(i));
+        src += s;
+    }
+
+    const Settings settings;
+    TokenList tokenList(settings, Standards::Language::CPP);
+    std::istringstream istr(src);
+    if (!tokenList.createTokens(istr)) {
+        std::cerr << "failed to create the tokens" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::size_t tokenCount = 0;
+    for (const Token *tok = tokenList.front(); tok; tok = tok->next())
+        ++tokenCount;
+    std::cout << tokenCount << " tokens, " << iterations << " iterations" << std::endl;
+
+    run("Token::Match", countInterpreted, tokenList.front(), iterations, tokenCount);
+    run("TOKEN_MATCH", countCompiled, tokenList.front(), iterations, tokenCount);
+#ifdef HAVE_MATCHCOMPILER
+    run("matchcompiler", countMatchCompiler, tokenList.front(), iterations, tokenCount);
+#endif
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This file is compiled twice: as is and after it has been processed by
+// tools/matchcompiler.py with MATCHBENCH_MATCHCOMPILER defined.
+
+#include "patterns.h"
+
+#include "token.h"
+#include "tokenmatch.h"
+
+#ifdef MATCHBENCH_MATCHCOMPILER
+std::size_t countMatchCompiler(const Token *tokens)
+#else
+std::size_t countInterpreted(const Token *tokens)
+#endif
+{
+    std::size_t count = 0;
+    for (const Token *tok = tokens; tok; tok = tok->next()) {
+        if (Token::Match(tok, "%name% ("))
+            ++count;
+        if (Token::Match(tok, "if|while|for|switch ("))
+            ++count;
+        if (Token::Match(tok, "[;{}] %name% = %num%|%name% ;"))
+            ++count;
+        if (Token::Match(tok, "return %name%|%num% ;|)"))
+            ++count;
+        if (Token::Match(tok, "} !!else"))
+            ++count;
+        if (Token::Match(tok, ") const| {"))
+            ++count;
+        if (Token::Match(tok, "%name% %op%|%assign% %name%|%num%"))
+            ++count;
+    }
+    return count;
+}
+
+#ifndef MATCHBENCH_MATCHCOMPILER
+std::size_t countCompiled(const Token *tokens)
+{
+    std::size_t count = 0;
+    for (const Token *tok = tokens; tok; tok = tok->next()) {
+        if (TOKEN_MATCH(tok, "%name% ("))
+            ++count;
+        if (TOKEN_MATCH(tok, "if|while|for|switch ("))
+            ++count;
+        if (TOKEN_MATCH(tok, "[;{}] %name% = %num%|%name% ;"))
+            ++count;
+        if (TOKEN_MATCH(tok, "return %name%|%num% ;|)"))
+            ++count;
+        if (TOKEN_MATCH(tok, "} !!else"))
+            ++count;
+        if (TOKEN_MATCH(tok, ") const| {"))
+            ++count;
+        if (TOKEN_MATCH(tok, "%name% %op%|%assign% %name%|%num%"))
+            ++count;
+    }
+    return count;
+}
+#endif
@@ -0,0 +1,35 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2025 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef patternsH
+#define patternsH
+
+#include <cstddef>
+
+class Token;
+
+/** count the matches of the patterns with Token::Match() */
+std::size_t countInterpreted(const Token *tokens);
+
+/** count the matches of the patterns with TOKEN_MATCH() */
+std::size_t countCompiled(const Token *tokens);
+
+/** count the matches of the patterns with the output of tools/matchcompiler.py */
+std::size_t countMatchCompiler(const Token *tokens);
+
+#endif // patternsH